@@ -24,7 +24,9 @@
 #include "collaborate/data_processor_sink.h"
 #include "collaborate/data_processor_source.h"
 #include "collaborate/event_logger.h"
+#include "collaborate/measurement_logger.h"
 #include "collaborate/modem_uhf_deploy.h"
+#include "collaborate/node_logger.h"
 #include "collaborate/observing_system_alpha.h"
 #include "collaborate/platform_orbit.h"
 #include "collaborate/scheduler_alpha.h"
@@ -36,6 +38,7 @@
 #include "collaborate/subsystem_power.h"
 #include "collaborate/subsystem_sensing.h"
 #include "collaborate/sun.h"
+#include "collaborate/tree_logger.h"
 
 namespace osse {
 namespace collaborate {
@@ -43,15 +46,24 @@ void AdvancedObservingSystemSimulation() {
   // Simulation Parameters
   constexpr uint64_t kNumTicks = 3600;
   constexpr uint64_t kSecondsPerTick = 1;
+  constexpr uint64_t kLogQueueDepth = 1024;
+  constexpr uint64_t kEventQueueSize = 8192;
 
   // Loggers
-  DataLogger data_log("output/data.nc4");
-  EventLogger event_log("output/events.txt");
+  DataLogger data_log("output/data.nc4", kLogQueueDepth);
+  EventLogger event_log("output/events.txt",
+                        true,
+                        kEventQueueSize,
+                        spdlog::async_overflow_policy::block);
   DataLogger net_log("output/network.nc4");
+  MeasurementLogger prectot_log("output/PRECTOT_measure.nc4");
+  MeasurementLogger tautot_log("output/TAUTOT_measure.nc4");
+  TreeLogger tree_log("output/trees.txt", TreeLogger::kFormat::EdgeList, 1);
 
   // Observing System
   SimulationClock clock(&data_log);
   SchedulerAlpha scheduler(&clock);
+  scheduler.set_tree_log(&tree_log);
   Sun sun(&clock);
   ObservingSystemAlpha system(&sun, &clock, &scheduler, &event_log, &net_log);
 
@@ -66,9 +78,10 @@ void AdvancedObservingSystemSimulation() {
   SubsystemComm comm(&comm_antenna, &uhf_modem);
   AntennaHelical sensing_antenna(30, 0, 0, 0);
   SensorCloudRadar cloud_radar("input/nc4/", 300);
-  SubsystemSensing cloud(&sensing_antenna, &cloud_radar);
+  SubsystemSensing cloud(&sensing_antenna, &cloud_radar, &tautot_log);
+  cloud.set_footprint(true);
   SensorRainRadar rain_radar("input/nc4/", 50);
-  SubsystemSensing rain(&sensing_antenna, &rain_radar);
+  SubsystemSensing rain(&sensing_antenna, &rain_radar, &prectot_log);
 
   // Launch
   std::string tle_path = "input/tle/cubesat.tle";
@@ -80,9 +93,12 @@ void AdvancedObservingSystemSimulation() {
   system.Launch(C1, 1, false, comm, rain, power_ss, &sink, &data_log);
 
   // Final Setup
-  data_log.Simulation(system.nodes().size(), kNumTicks);
+  data_log.SimulationMatrix(system.nodes().size(), kNumTicks);
+  NodeLogger node_log(&data_log, system.nodes().size());
+  system.set_node_log(&node_log);
   net_log.UnweightedNetwork(system.nodes().size(), kNumTicks);
   event_log.Initialize("info", "info", true);
+  event_log.OpenRecords("output/events.bin");
   system.SeedMany(kNumTicks, 0);
 
   // Simulation
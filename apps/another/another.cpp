@@ -26,7 +26,9 @@
 #include "collaborate/data_processor_source.h"
 #include "collaborate/data_processor_template.h"
 #include "collaborate/event_logger.h"
+#include "collaborate/measurement_logger.h"
 #include "collaborate/modem_uhf_deploy.h"
+#include "collaborate/node_logger.h"
 #include "collaborate/observing_system_alpha.h"
 #include "collaborate/platform_orbit.h"
 #include "collaborate/scheduler_alpha.h"
@@ -47,11 +49,14 @@ void SimpleObservingSystemSimulation() {
   // Simulation Parameters
   constexpr uint64_t kNumTicks = 500;
   constexpr uint64_t kSecondsPerTick = 1;
+  constexpr uint64_t kLogQueueDepth = 1024;
 
   // Loggers
-  DataLogger data_log("output/data.nc4");
+  DataLogger data_log("output/data.nc4", kLogQueueDepth);
   EventLogger event_log("output/events.txt");
   DataLogger net_log("output/network.nc4");
+  MeasurementLogger prectot_log("output/PRECTOT_measure.nc4");
+  MeasurementLogger tautot_log("output/TAUTOT_measure.nc4");
 
   // Observing System
   SimulationClock clock(&data_log, 2021, 4, 20, 19, 0, 0);
@@ -69,9 +74,9 @@ void SimpleObservingSystemSimulation() {
   SubsystemComm comm(&comm_antenna, &uhf_modem);
   AntennaHelical sensing_antenna(30, 0, 0, 0);
   SensorRainRadar rain_radar("input/nc4/", 30);
-  SubsystemSensing rain(&sensing_antenna, &rain_radar);
+  SubsystemSensing rain(&sensing_antenna, &rain_radar, &prectot_log);
   SensorOpticalImager optical_imager("input/nc4/", 30);
-  SubsystemSensing optical(&sensing_antenna, &optical_imager);
+  SubsystemSensing optical(&sensing_antenna, &optical_imager, &tautot_log);
 
   // Launch
   std::string tle_path1 = "input/tle/iss.tle";
@@ -92,7 +97,9 @@ void SimpleObservingSystemSimulation() {
   // system.Launch(C3, 2, false, comm, optical, power_ss, &processor, &data_log);
 
   // Final Setup
-  data_log.Simulation(system.nodes().size(), kNumTicks);
+  data_log.SimulationMatrix(system.nodes().size(), kNumTicks);
+  NodeLogger node_log(&data_log, system.nodes().size());
+  system.set_node_log(&node_log);
   net_log.UnweightedNetwork(system.nodes().size(), kNumTicks);
   event_log.Initialize("info", "info", true);
   system.Seed(kNumTicks);
@@ -110,11 +117,14 @@ void CollaborativeObservingSystemSimulation() {
   // Simulation Parameters
   constexpr uint64_t kNumTicks = 10000;
   constexpr uint64_t kSecondsPerTick = 1;
+  constexpr uint64_t kLogQueueDepth = 1024;
 
   // Loggers
-  DataLogger data_log("output/data.nc4");
+  DataLogger data_log("output/data.nc4", kLogQueueDepth);
   EventLogger event_log("output/events.txt");
   DataLogger net_log("output/network.nc4");
+  MeasurementLogger prectot_log("output/PRECTOT_measure.nc4");
+  MeasurementLogger tautot_log("output/TAUTOT_measure.nc4");
 
   // Observing System
   SimulationClock clock(&data_log, 2021, 4, 20, 19, 0, 0);
@@ -134,11 +144,11 @@ void CollaborativeObservingSystemSimulation() {
   SubsystemComm comm(&comm_antenna, &uhf_modem);
   AntennaHelical sensing_antenna(30, 0, 0, 0);
   SensorCloudRadar cloud_radar("input/nc4/", 120);
-  SubsystemSensing cloud(&sensing_antenna, &cloud_radar);
+  SubsystemSensing cloud(&sensing_antenna, &cloud_radar, &tautot_log);
   SensorRainRadar rain_radar("input/nc4/", 30);
-  SubsystemSensing rain(&sensing_antenna, &rain_radar);
+  SubsystemSensing rain(&sensing_antenna, &rain_radar, &prectot_log);
   SensorOpticalImager optical_imager("input/nc4/", 30);
-  SubsystemSensing optical(&sensing_antenna, &optical_imager);
+  SubsystemSensing optical(&sensing_antenna, &optical_imager, &tautot_log);
 
   // Collaborative
   std::string tle_path1 = "input/tle/cloudsat.tle";
@@ -155,7 +165,9 @@ void CollaborativeObservingSystemSimulation() {
   system.Launch(C3, 2, false, comm, optical, power_ss, &sink, &data_log);
   
   // Final Setup
-  data_log.Simulation(system.nodes().size(), kNumTicks);
+  data_log.SimulationMatrix(system.nodes().size(), kNumTicks);
+  NodeLogger node_log(&data_log, system.nodes().size());
+  system.set_node_log(&node_log);
   net_log.UnweightedNetwork(system.nodes().size(), kNumTicks);
   event_log.Initialize("info", "info", true);
   system.SeedMany(kNumTicks, 0);
@@ -173,12 +185,15 @@ void SecondCollaborativeObservingSystemSimulation() {
   // Simulation Parameters
   constexpr uint64_t kNumTicks = 10000;
   constexpr uint64_t kSecondsPerTick = 1;
+  constexpr uint64_t kLogQueueDepth = 1024;
   constexpr bool exceptional = true;
 
   // Loggers
-  DataLogger data_log("output/data.nc4");
+  DataLogger data_log("output/data.nc4", kLogQueueDepth);
   EventLogger event_log("output/events.txt");
   DataLogger net_log("output/network.nc4");
+  MeasurementLogger prectot_log("output/PRECTOT_measure.nc4");
+  MeasurementLogger tautot_log("output/TAUTOT_measure.nc4");
 
   // Observing System
   SimulationClock clock(&data_log, 2021, 4, 20, 19, 0, 0);
@@ -199,11 +214,11 @@ void SecondCollaborativeObservingSystemSimulation() {
   SubsystemComm comm(&comm_antenna, &uhf_modem);
   AntennaHelical sensing_antenna(30, 0, 0, 0);
   SensorCloudRadar cloud_radar("input/nc4/", 10);
-  SubsystemSensing cloud(&sensing_antenna, &cloud_radar);
+  SubsystemSensing cloud(&sensing_antenna, &cloud_radar, &tautot_log);
   SensorRainRadar rain_radar("input/nc4/", 30);
-  SubsystemSensing rain(&sensing_antenna, &rain_radar);
+  SubsystemSensing rain(&sensing_antenna, &rain_radar, &prectot_log);
   SensorOpticalImager optical_imager("input/nc4/", 30);
-  SubsystemSensing optical(&sensing_antenna, &optical_imager);
+  SubsystemSensing optical(&sensing_antenna, &optical_imager, &tautot_log);
 
   // Collaborative
   std::string tle_path1 = "input/tle/cloudsat.tle";
@@ -220,7 +235,9 @@ void SecondCollaborativeObservingSystemSimulation() {
   system.Launch(C3, 2, false, comm, optical, power_ss, &sink, &data_log);
   
   // Final Setup
-  data_log.Simulation(system.nodes().size(), kNumTicks);
+  data_log.SimulationMatrix(system.nodes().size(), kNumTicks);
+  NodeLogger node_log(&data_log, system.nodes().size());
+  system.set_node_log(&node_log);
   net_log.UnweightedNetwork(system.nodes().size(), kNumTicks);
   event_log.Initialize("info", "info", true);
   system.SeedManyMore(kNumTicks, 0);
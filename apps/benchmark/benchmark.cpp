@@ -0,0 +1,166 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "collaborate/antenna_dipole.h"
+#include "collaborate/antenna_helical.h"
+#include "collaborate/battery.h"
+#include "collaborate/data_logger.h"
+#include "collaborate/data_processor_template.h"
+#include "collaborate/event_logger.h"
+#include "collaborate/measurement_logger.h"
+#include "collaborate/modem_uhf_deploy.h"
+#include "collaborate/node.h"
+#include "collaborate/node_logger.h"
+#include "collaborate/observing_system_alpha.h"
+#include "collaborate/platform_orbit.h"
+#include "collaborate/scheduler_alpha.h"
+#include "collaborate/sensor_cloud_radar.h"
+#include "collaborate/simulation_clock.h"
+#include "collaborate/solar_panel.h"
+#include "collaborate/subsystem_comm.h"
+#include "collaborate/subsystem_power.h"
+#include "collaborate/subsystem_sensing.h"
+#include "collaborate/sun.h"
+#include "collaborate/trace_logger.h"
+
+/// @brief Number of heap allocations made so far (by any thread)
+static std::atomic<uint64_t> num_allocations(0);
+
+void* operator new(std::size_t _size) {
+  ++num_allocations;
+  void* pointer = std::malloc(_size == 0 ? 1 : _size);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void operator delete(void* _pointer) noexcept {
+  std::free(_pointer);
+}
+
+namespace osse {
+namespace collaborate {
+/// @brief Counts heap allocations made by the node logging paths
+/// @details Nodes are propagated and powered each tick, then logged through
+/// Node::BufferDataLog and through a NodeLogger writing to a trace. Ticks
+/// that write a full buffer to the NetCDF library are counted separately.
+/// @returns Number of allocations in steady-state ticks
+uint64_t LogAllocationBenchmark() {
+  // Simulation Parameters
+  constexpr uint64_t kNumTicks = 5000;
+  constexpr uint64_t kSecondsPerTick = 1;
+
+  // Loggers
+  DataLogger data_log("output/benchmark.nc4");
+  TraceLogger trace_log("output/benchmark.trc");
+  EventLogger event_log("output/benchmark.txt");
+  DataLogger net_log("output/benchmark_network.nc4");
+  MeasurementLogger tautot_log("output/benchmark_measure.nc4");
+
+  // Observing System
+  SimulationClock clock(&data_log);
+  SchedulerAlpha scheduler(&clock);
+  Sun sun(&clock);
+  ObservingSystemAlpha system(&sun, &clock, &scheduler, &event_log, &net_log);
+
+  // Satellite Hardware
+  DataProcessorTemplate processor;
+  Battery battery(0.9333, 6, 12.9, 85);
+  SolarPanel panel(29, 0.06, 0, 0, 0, &sun);
+  SubsystemPower power_ss(battery, {panel, panel}, 6.2425);
+  AntennaDipole comm_antenna(30, 0, 0, 0);
+  ModemUhfDeploy uhf_modem;
+  SubsystemComm comm(&comm_antenna, &uhf_modem);
+  AntennaHelical sensing_antenna(30, 0, 0, 0);
+  SensorCloudRadar cloud_radar("input/nc4/", 10);
+  SubsystemSensing cloud(&sensing_antenna, &cloud_radar, &tautot_log);
+
+  // Launch
+  std::string tle_path = "input/tle/cubesat.tle";
+  std::vector<PlatformOrbit> orbits = PlatformOrbitList(tle_path);
+  std::vector<PlatformOrbit> first = orbits[0].Duplicate(1, 5, 1, 1, 0, 0);
+  system.Launch(first, 0, false, comm, cloud, power_ss, &processor, &data_log);
+
+  // Final Setup
+  std::vector<Node*> nodes = system.nodes();
+  data_log.Simulation(nodes.size(), kNumTicks);
+  trace_log.SimulationMatrix(nodes.size(), kNumTicks);
+  NodeLogger node_log(&trace_log, nodes.size());
+  event_log.Initialize("info", "info", false);
+
+  // Simulation
+  uint64_t buffer_steady = 0;
+  uint64_t buffer_flush = 0;
+  uint64_t shared_steady = 0;
+  Node::PartialLog log;
+  Node::LogMask mask;
+  for (uint64_t tick = 0; tick < kNumTicks; ++tick) {
+    sun.Update(0);
+    for (auto node : nodes) {
+      node->Update(0, false, false, false, true, true, false);
+    }
+    uint64_t start = num_allocations;
+    for (auto node : nodes) {
+      node->BufferDataLog();
+    }
+    uint64_t count = num_allocations - start;
+    if ((tick > 0) && (tick % Node::kLogBufferSize == 0)) {
+      buffer_flush += count;
+    } else {
+      buffer_steady += count;
+    }
+    start = num_allocations;
+    for (auto node : nodes) {
+      if (node_log.Due(node->constellation(), &mask)) {
+        node->ObtainLog(mask, &log);
+        node_log.Buffer(mask, log);
+      }
+    }
+    node_log.Advance();
+    shared_steady += num_allocations - start;
+    clock.Tick(kSecondsPerTick);
+  }
+  for (auto node : nodes) {
+    node->Flush();
+  }
+  node_log.Flush();
+  clock.Flush();
+  std::cout << nodes.size() << " nodes, " << kNumTicks << " ticks"
+            << std::endl
+            << "Node::BufferDataLog: " << buffer_steady
+            << " allocations in steady-state ticks, " << buffer_flush
+            << " in buffer writes" << std::endl
+            << "NodeLogger (trace): " << shared_steady
+            << " allocations, including buffer writes" << std::endl;
+  return buffer_steady + shared_steady;
+}
+}  // namespace collaborate
+}  // namespace osse
+
+int main() {
+  if (osse::collaborate::LogAllocationBenchmark() > 0) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,39 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <iostream>
+#include <string>
+
+#include "collaborate/trace_logger.h"
+
+int main(int argc, char* argv[]) {
+  // Defaults match the paths used by the example simulations
+  std::string trace_path = "output/data.trc";
+  std::string netcdf_path = "output/data.nc4";
+  if (argc > 1) {
+    trace_path = argv[1];
+  }
+  if (argc > 2) {
+    netcdf_path = argv[2];
+  }
+  if (argc > 3) {
+    std::cerr << "usage: " << argv[0] << " [trace] [netcdf]" << std::endl;
+    return 1;
+  }
+  if (!osse::collaborate::TraceLogger::Convert(trace_path, netcdf_path)) {
+    return 1;
+  }
+  return 0;
+}
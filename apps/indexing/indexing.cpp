@@ -0,0 +1,202 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "collaborate/earth.h"
+#include "collaborate/earth_data.h"
+#include "collaborate/util.h"
+
+namespace osse {
+namespace collaborate {
+/// @brief The original latitude grid search (the reference)
+/// @param[in] _latitude_rad Latitude (radians)
+/// @returns Index of the nearest latitude value
+uint16_t SearchLatitude(const double& _latitude_rad) {
+  double latitude_rad = -1 * util::kPiByTwoRad;
+  uint16_t index = 0;
+  bool flag = false;
+  while (index < earth::kNumLats && !flag) {
+    if (latitude_rad > _latitude_rad) {
+      flag = true;
+    }
+    latitude_rad += earth::kLatIncrementRad;
+    ++index;
+  }
+  return index;
+}
+
+/// @brief The original longitude grid search (the reference)
+/// @param[in] _longitude_rad Longitude (radians)
+/// @returns Index of the nearest longitude value
+uint16_t SearchLongitude(const double& _longitude_rad) {
+  double longitude_rad = -1 * util::kPiRad;
+  uint16_t index = 0;
+  bool flag = false;
+  while (index < earth::kNumLons && !flag) {
+    if (longitude_rad > _longitude_rad) {
+      flag = true;
+    }
+    longitude_rad += earth::kLonIncrementRad;
+    ++index;
+  }
+  return index;
+}
+
+/// @brief Compares a closed-form index with the reference search
+/// @details The two may only differ where the reference ran off the grid
+/// (it returned the number of cells, which the closed form clamps), or
+/// within rounding of a grid line (the reference accumulates the spacing).
+/// @param[in] _value_rad Latitude or longitude (radians)
+/// @param[in] _start_rad First grid line (radians)
+/// @param[in] _increment_rad Grid spacing (radians)
+/// @param[in] _num_cells Number of cells
+/// @param[in] _index Closed-form index
+/// @param[in] _reference Reference index
+/// @param[in,out] _edges Number of clamped indices
+/// @returns Whether or not the indices agree
+bool Agree(const double& _value_rad,
+           const double& _start_rad,
+           const double& _increment_rad,
+           const uint64_t& _num_cells,
+           const uint16_t& _index,
+           const uint16_t& _reference,
+           uint64_t* _edges) {
+  constexpr double kToleranceRad = 1e-9;
+  if (_index == _reference) {
+    return true;
+  }
+  if ((_reference == _num_cells) && (_index == _num_cells - 1)) {
+    ++*_edges;
+    return true;
+  }
+  double lines = (_value_rad - _start_rad) / _increment_rad;
+  double distance_rad = std::abs(lines - std::round(lines)) * _increment_rad;
+  return distance_rad < kToleranceRad;
+}
+
+/// @brief Checks closed-form grid indexing against the original search
+/// @details Sweeps every cell (several points per cell, past both edges)
+/// and random points, then times both methods.
+/// @returns Number of disagreements
+uint64_t IndexingCheck() {
+  constexpr uint64_t kPointsPerCell = 7;
+  constexpr uint64_t kNumRandom = 1000000;
+  constexpr uint64_t kNumTimed = 20000;
+  uint64_t failures = 0;
+  uint64_t edges = 0;
+  uint64_t checked = 0;
+  // Latitude sweep
+  double step_rad = earth::kLatIncrementRad / kPointsPerCell;
+  for (double latitude_rad = -util::kPiByTwoRad - 10 * step_rad;
+       latitude_rad < util::kPiByTwoRad + 10 * step_rad;
+       latitude_rad += step_rad) {
+    if (!Agree(latitude_rad,
+               -util::kPiByTwoRad,
+               earth::kLatIncrementRad,
+               earth::kNumLats,
+               EarthData::IndexLatitude(latitude_rad),
+               SearchLatitude(latitude_rad),
+               &edges)) {
+      ++failures;
+    }
+    ++checked;
+  }
+  // Longitude sweep
+  step_rad = earth::kLonIncrementRad / kPointsPerCell;
+  for (double longitude_rad = -util::kPiRad - 10 * step_rad;
+       longitude_rad < util::kPiRad + 10 * step_rad;
+       longitude_rad += step_rad) {
+    if (!Agree(longitude_rad,
+               -util::kPiRad,
+               earth::kLonIncrementRad,
+               earth::kNumLons,
+               EarthData::IndexLongitude(longitude_rad),
+               SearchLongitude(longitude_rad),
+               &edges)) {
+      ++failures;
+    }
+    ++checked;
+  }
+  // Random points
+  std::mt19937_64 generator(42);
+  std::uniform_real_distribution<double> latitudes(-util::kPiByTwoRad,
+                                                   util::kPiByTwoRad);
+  std::uniform_real_distribution<double> longitudes(-util::kPiRad,
+                                                    util::kPiRad);
+  for (uint64_t i = 0; i < kNumRandom; ++i) {
+    double latitude_rad = latitudes(generator);
+    double longitude_rad = longitudes(generator);
+    if (!Agree(latitude_rad,
+               -util::kPiByTwoRad,
+               earth::kLatIncrementRad,
+               earth::kNumLats,
+               EarthData::IndexLatitude(latitude_rad),
+               SearchLatitude(latitude_rad),
+               &edges)
+        || !Agree(longitude_rad,
+                  -util::kPiRad,
+                  earth::kLonIncrementRad,
+                  earth::kNumLons,
+                  EarthData::IndexLongitude(longitude_rad),
+                  SearchLongitude(longitude_rad),
+                  &edges)) {
+      ++failures;
+    }
+    checked += 2;
+  }
+  // Timing
+  std::vector<double> latitude_rad(kNumTimed);
+  std::vector<double> longitude_rad(kNumTimed);
+  for (uint64_t i = 0; i < kNumTimed; ++i) {
+    latitude_rad[i] = latitudes(generator);
+    longitude_rad[i] = longitudes(generator);
+  }
+  uint64_t sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < kNumTimed; ++i) {
+    sum += SearchLatitude(latitude_rad[i]) + SearchLongitude(longitude_rad[i]);
+  }
+  auto middle = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < kNumTimed; ++i) {
+    sum += EarthData::IndexLatitude(latitude_rad[i])
+           + EarthData::IndexLongitude(longitude_rad[i]);
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::nano> search_ns = middle - start;
+  std::chrono::duration<double, std::nano> closed_ns = end - middle;
+  std::cout << checked << " indices checked, " << failures
+            << " disagreements, " << edges << " clamped at the grid edge"
+            << std::endl
+            << "Search: " << search_ns.count() / kNumTimed
+            << " ns per lookup, closed form: "
+            << closed_ns.count() / kNumTimed << " ns per lookup (checksum "
+            << sum << ")" << std::endl;
+  return failures;
+}
+}  // namespace collaborate
+}  // namespace osse
+
+int main() {
+  if (osse::collaborate::IndexingCheck() > 0) {
+    return 1;
+  }
+  return 0;
+}
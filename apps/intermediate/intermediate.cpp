@@ -24,7 +24,9 @@
 #include "collaborate/data_processor_source.h"
 #include "collaborate/data_processor_template.h"
 #include "collaborate/event_logger.h"
+#include "collaborate/measurement_logger.h"
 #include "collaborate/modem_uhf_deploy.h"
+#include "collaborate/node_logger.h"
 #include "collaborate/observing_system_alpha.h"
 #include "collaborate/platform_orbit.h"
 #include "collaborate/scheduler_alpha.h"
@@ -43,17 +45,21 @@ void IntermediateObservingSystemSimulation() {
   // Simulation Parameters
   constexpr uint64_t kNumTicks = 300;
   constexpr uint64_t kSecondsPerTick = 1;
+  constexpr uint64_t kLogQueueDepth = 1024;
+  constexpr uint64_t kSnapshotTicks = 60;
 
   // Loggers
-  DataLogger data_log("output/data.nc4");
+  DataLogger data_log("output/data.nc4", kLogQueueDepth);
   EventLogger event_log("output/events.txt");
   DataLogger net_log("output/network.nc4");
+  MeasurementLogger tautot_log("output/TAUTOT_measure.nc4");
 
   // Observing System
   SimulationClock clock(&data_log);
   SchedulerAlpha scheduler(&clock);
   Sun sun(&clock);
-  ObservingSystemAlpha system(&sun, &clock, &scheduler, &event_log, &net_log);
+  ObservingSystemAlpha system(&sun, &clock, &scheduler, &event_log, &net_log,
+                              false, kSnapshotTicks);
 
   // Satellite Hardware
   DataProcessorTemplate processor;
@@ -65,7 +71,7 @@ void IntermediateObservingSystemSimulation() {
   SubsystemComm comm(&comm_antenna, &uhf_modem);
   AntennaHelical sensing_antenna(30, 0, 0, 0);
   SensorCloudRadar cloud_radar("input/nc4/", 100);
-  SubsystemSensing cloud(&sensing_antenna, &cloud_radar);
+  SubsystemSensing cloud(&sensing_antenna, &cloud_radar, &tautot_log);
 
   // Launch
   std::string tle_path = "input/tle/cubesat.tle";
@@ -73,20 +79,26 @@ void IntermediateObservingSystemSimulation() {
   system.Launch(orbits, 0, true, comm, cloud, power_ss, &processor, &data_log);
 
   // Final Setup
-  data_log.Simulation(system.nodes().size(), kNumTicks);
-  net_log.UnweightedNetwork(system.nodes().size(), kNumTicks);
+  data_log.SimulationMatrix(system.nodes().size(), kNumTicks);
+  NodeLogger node_log(&data_log, system.nodes().size());
+  system.set_node_log(&node_log);
+  net_log.UnweightedEvents(system.nodes().size(), kNumTicks);
   event_log.Initialize("info", "info", true);
   system.Seed(kNumTicks);
 
   // Simulation
   DataLogger distance_log("output/distance.nc4");
   distance_log.WeightedNetwork(system.nodes().size(), kNumTicks);
+  DataLogger path_log("output/path.nc4");
+  path_log.WeightedNetwork(system.nodes().size(), kNumTicks);
   GraphWeighted dist(&distance_log);
   for (uint64_t tick = 0; tick < kNumTicks; ++tick) {
     system.Update();
     system.LinesOfSight();
     system.scheduler()->AllDist(&dist);
     dist.Log(system.nodes().size(), tick);
+    std::vector<double> paths = dist.AllPairs(0);
+    path_log.LogWeightedGraph(tick, paths.data(), system.nodes().size());
     clock.Tick(kSecondsPerTick);
   }
   system.Complete();
@@ -24,7 +24,9 @@
 #include "collaborate/data_processor_source.h"
 #include "collaborate/data_processor_template.h"
 #include "collaborate/event_logger.h"
+#include "collaborate/measurement_logger.h"
 #include "collaborate/modem_uhf_deploy.h"
+#include "collaborate/node_logger.h"
 #include "collaborate/observing_system_alpha.h"
 #include "collaborate/platform_orbit.h"
 #include "collaborate/scheduler_alpha.h"
@@ -43,11 +45,13 @@ void SimpleObservingSystemSimulation() {
   // Simulation Parameters
   constexpr uint64_t kNumTicks = 10000;
   constexpr uint64_t kSecondsPerTick = 1;
+  constexpr uint64_t kLogQueueDepth = 1024;
 
   // Loggers
-  DataLogger data_log("output/data.nc4");
+  DataLogger data_log("output/data.nc4", kLogQueueDepth);
   EventLogger event_log("output/events.txt");
   DataLogger net_log("output/network.nc4");
+  MeasurementLogger tautot_log("output/TAUTOT_measure.nc4");
 
   // Observing System
   SimulationClock clock(&data_log);
@@ -66,7 +70,7 @@ void SimpleObservingSystemSimulation() {
   SubsystemComm comm(&comm_antenna, &uhf_modem);
   AntennaHelical sensing_antenna(30, 0, 0, 0);
   SensorCloudRadar cloud_radar("input/nc4/", 10);
-  SubsystemSensing cloud(&sensing_antenna, &cloud_radar);
+  SubsystemSensing cloud(&sensing_antenna, &cloud_radar, &tautot_log);
 
   // Launch
   std::string tle_path = "input/tle/cubesat.tle";
@@ -75,7 +79,9 @@ void SimpleObservingSystemSimulation() {
   system.Launch(first, 0, true, comm, cloud, power_ss, &processor, &data_log);
 
   // Final Setup
-  data_log.Simulation(system.nodes().size(), kNumTicks);
+  data_log.SimulationMatrix(system.nodes().size(), kNumTicks);
+  NodeLogger node_log(&data_log, system.nodes().size());
+  system.set_node_log(&node_log);
   net_log.UnweightedNetwork(system.nodes().size(), kNumTicks);
   event_log.Initialize("info", "info", true);
 
@@ -25,7 +25,9 @@
 #include "collaborate/data_processor_source.h"
 #include "collaborate/data_processor_template.h"
 #include "collaborate/event_logger.h"
+#include "collaborate/measurement_logger.h"
 #include "collaborate/modem_uhf_deploy.h"
+#include "collaborate/node_logger.h"
 #include "collaborate/observing_system_alpha.h"
 #include "collaborate/platform_orbit.h"
 #include "collaborate/scheduler_alpha.h"
@@ -44,11 +46,13 @@ void SimpleObservingSystemSimulation() {
   // Simulation Parameters
   constexpr uint64_t kNumTicks = 400;
   constexpr uint64_t kSecondsPerTick = 1;
+  constexpr uint64_t kLogQueueDepth = 1024;
 
   // Loggers
-  DataLogger data_log("output/data.nc4");
+  DataLogger data_log("output/data.nc4", kLogQueueDepth);
   EventLogger event_log("output/events.txt");
   DataLogger net_log("output/network.nc4");
+  MeasurementLogger tautot_log("output/TAUTOT_measure.nc4");
 
   // Observing System
   SimulationClock clock(&data_log);
@@ -67,7 +71,7 @@ void SimpleObservingSystemSimulation() {
   SubsystemComm comm(&comm_antenna, &uhf_modem);
   AntennaHelical sensing_antenna(30, 0, 0, 0);
   SensorCloudRadar cloud_radar("input/nc4/", 10);
-  SubsystemSensing cloud(&sensing_antenna, &cloud_radar);
+  SubsystemSensing cloud(&sensing_antenna, &cloud_radar, &tautot_log);
 
   // GPM-CORE
   std::array<std::string, 3> tle_24 = {"GPM-CORE",
@@ -94,7 +98,9 @@ void SimpleObservingSystemSimulation() {
   system.Launch(c_75, 2, false, comm, cloud, power_ss, &processor, &data_log);
 
   // Final Setup
-  data_log.Simulation(system.nodes().size(), kNumTicks);
+  data_log.SimulationMatrix(system.nodes().size(), kNumTicks);
+  NodeLogger node_log(&data_log, system.nodes().size());
+  system.set_node_log(&node_log);
   net_log.UnweightedNetwork(system.nodes().size(), kNumTicks);
   event_log.Initialize("info", "info", true);
 
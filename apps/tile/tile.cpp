@@ -0,0 +1,48 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "collaborate/earth_data.h"
+#include "collaborate/earth_tiles.h"
+
+int main(int argc, char* argv[]) {
+  // Defaults match the paths and variables used by the example sensors
+  std::string root = "input/nc4/";
+  std::vector<std::string> variables = {"TAUTOT", "PRECTOT"};
+  if (argc > 1) {
+    root = argv[1];
+  }
+  if (argc > 2) {
+    variables.assign(argv + 2, argv + argc);
+  }
+  int status = 0;
+  for (auto& path : osse::collaborate::EarthData::FindDataPaths(root)) {
+    for (auto& variable : variables) {
+      std::string tiles_path = osse::collaborate::EarthTiles::Path(path,
+                                                                   variable);
+      if (!osse::collaborate::EarthTiles::Convert(path,
+                                                  variable,
+                                                  tiles_path)) {
+        status = 1;
+        continue;
+      }
+      std::cout << tiles_path << std::endl;
+    }
+  }
+  return status;
+}
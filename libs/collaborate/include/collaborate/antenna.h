@@ -27,6 +27,10 @@ namespace collaborate {
 /// @image latex vector/antennas.pdf width=\textwidth
 class Antenna {
  public:
+  /// @brief Drop in gain at the edge of the beam (decibels)
+  static constexpr double kHalfPowerDb = 3;
+  /// @brief Beamwidth of a pattern with no half-power crossing
+  static constexpr double kNoBeamwidthRad = 0;
   /// @brief Constructor
   /// @param[in] _max_gain_db Maximum gain (decibels)
   /// @param[in] _roll_rad Roll angle to host body reference frame (radians)
@@ -42,6 +46,12 @@ class Antenna {
   /// @returns Directional gain (decibels)
   virtual double GainDb(const double& _theta_rad,
                         const double& _phi_rad) const = 0;
+  /// @brief Obtains the half-power (3 dB) beamwidth
+  /// @details Measured in the phi = 0 plane from the gain at boresight
+  /// (the patterns are symmetrical in phi)
+  /// @returns Full beamwidth (radians, kNoBeamwidthRad if the gain never
+  /// falls 3 dB below boresight)
+  double BeamwidthRad() const;
   /// @brief Logs the antenna pattern to a file
   /// @param[in] _path File path
   void Log(const std::string& _path) const;
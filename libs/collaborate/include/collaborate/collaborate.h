@@ -31,15 +31,19 @@
 #include "collaborate/data_processor_template.h"
 #include "collaborate/earth.h"
 #include "collaborate/earth_data.h"
+#include "collaborate/earth_tiles.h"
 #include "collaborate/event_logger.h"
 #include "collaborate/geodetic.h"
 #include "collaborate/graph.h"
 #include "collaborate/graph_unweighted.h"
 #include "collaborate/graph_weighted.h"
+#include "collaborate/indexed_heap.h"
+#include "collaborate/measurement_logger.h"
 #include "collaborate/modem.h"
 #include "collaborate/modem_uhf_deploy.h"
 #include "collaborate/modem_uhf_station.h"
 #include "collaborate/node.h"
+#include "collaborate/node_logger.h"
 #include "collaborate/observing_system.h"
 #include "collaborate/observing_system_alpha.h"
 #include "collaborate/orbital_state.h"
@@ -63,7 +67,9 @@
 #include "collaborate/simulation_clock.h"
 #include "collaborate/solar_panel.h"
 #include "collaborate/sun.h"
+#include "collaborate/trace_logger.h"
 #include "collaborate/tree.h"
+#include "collaborate/tree_logger.h"
 #include "collaborate/util.h"
 #include "collaborate/vector.h"
 
@@ -16,8 +16,15 @@
 #ifndef LIBS_COLLABORATE_INCLUDE_COLLABORATE_DATA_LOGGER_H_
 #define LIBS_COLLABORATE_INCLUDE_COLLABORATE_DATA_LOGGER_H_
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "netcdf/ncFile.h"
@@ -29,18 +36,63 @@ namespace collaborate {
 
 /// @class DataLogger
 /// @brief An interface to the netcdf library
+/// @details An asynchronous logger copies each buffer handed to a Log method
+/// into a bounded queue, which a dedicated thread drains in order, so writes
+/// to the same variable land in the order they were logged. A full queue
+/// blocks the caller until the writer catches up. NetCDF is not thread safe,
+/// so every logger serializes its library calls on one shared mutex.
 class DataLogger {
  public:
+  /// @brief Storage settings applied to variables as they are defined
+  typedef struct StoragePolicy {
+    /// @brief Elements per chunk along the time dimension (defaults to the
+    /// length of the node log buffers)
+    size_t chunk_length;
+    /// @brief Deflate level (0 for none, up to 9)
+    int deflate_level;
+    /// @brief Whether or not to apply the shuffle filter
+    bool shuffle;
+    /// @brief Whether or not the time dimension is unlimited
+    bool unlimited;
+  } StoragePolicy;
   /// @brief Constructor
   /// @param[in] _path File sink path
   explicit DataLogger(const std::string& _path);
+  /// @brief Constructor (asynchronous)
+  /// @param[in] _path File sink path
+  /// @param[in] _queue_depth Maximum number of queued writes
+  DataLogger(const std::string& _path, const uint64_t& _queue_depth);
+  /// @brief Destructor (drains queued writes and closes the file)
+  ~DataLogger();
+  /// @brief Blocks until every queued write has reached the file
+  /// @details Rethrows the exception of a failed background write
+  void Wait();
+  /// @brief Get the lock that serializes calls into the NetCDF library
+  /// @returns netcdf_mutex_ NetCDF library lock (also for readers)
+  static std::mutex& netcdf_mutex() {return netcdf_mutex_;}
+  /// @brief Set storage policy (applies to variables defined afterwards)
+  /// @param[in] _storage Storage policy
+  void set_storage(const StoragePolicy& _storage) {storage_ = _storage;}
+  /// @brief Get storage policy
+  /// @returns storage_ Storage policy
+  const StoragePolicy& storage() const {return storage_;}
   /// @brief Sets up the netcdf file for logging node data
   /// @param[in] _num_nodes Number of nodes
   /// @param[in] _ticks Number of simulation ticks
   void Simulation(const uint16_t& _num_nodes, const uint64_t& _ticks);
+  /// @brief Sets up the netcdf file for logging node data as [node, time]
+  /// @details Holds the same variables as Simulation, but each node
+  /// parameter is one 2-D variable in the root group (see NodeLogger)
+  /// @param[in] _num_nodes Number of nodes
+  /// @param[in] _ticks Number of simulation ticks
+  void SimulationMatrix(const uint16_t& _num_nodes, const uint64_t& _ticks);
   /// @brief Sets up the netcdf file for logging measurement data
   /// @param[in] _ticks Number of simulation ticks
   void Measurement(const uint64_t& _ticks);
+  /// @brief Sets up the netcdf file for a ragged array of measurements
+  /// @details Uses the CF contiguous ragged array representation, with
+  /// unlimited "obs" (sample) and "instance" (measurement) dimensions
+  void RaggedMeasurement();
   /// @brief Sets up the netcdf file for logging communication parameters
   /// @param[in] _ticks Number of simulation ticks
   void Channel(const uint64_t& _ticks);
@@ -56,9 +108,21 @@ class DataLogger {
                     const T* _values,
                     const uint64_t& _index,
                     const uint64_t& _count) {
-    netCDF::NcGroup group = groups_[_node_index];
-    netCDF::NcVar variable = group.getVar(_variable);
-    variable.putVar({_index}, {_count}, _values);
+    Write(groups_[_node_index], _variable, {_index}, {_count}, _values);
+  }
+  /// @brief Logs a node-major buffer of [node, time] data
+  /// @param[in] _variable NetCDF variable name
+  /// @param[in] _values Array of values (count values for each node)
+  /// @param[in] _index Time index in NetCDF variable
+  /// @param[in] _num_nodes Number of nodes
+  /// @param[in] _count Count of time steps to transfer
+  template <class T>
+  void LogMatrix(const std::string& _variable,
+                 const T* _values,
+                 const uint64_t& _index,
+                 const uint16_t& _num_nodes,
+                 const uint64_t& _count) {
+    Write(ncfile_, _variable, {0, _index}, {_num_nodes, _count}, _values);
   }
   /// @brief Logs a buffer of time series data
   /// @param[in] _variable NetCDF variable name
@@ -68,8 +132,19 @@ class DataLogger {
   void LogSeries(const std::string& _variable,
                  const T* _values,
                  const uint64_t& _count) {
-    netCDF::NcVar variable = ncfile_.getVar(_variable);
-    variable.putVar({0}, {_count}, _values);
+    Write(ncfile_, _variable, {0}, {_count}, _values);
+  }
+  /// @brief Logs a buffer of time series data at an offset
+  /// @param[in] _variable NetCDF variable name
+  /// @param[in] _values Array of values
+  /// @param[in] _index Index in NetCDF variable
+  /// @param[in] _count Count of elements to transfer
+  template <class T>
+  void LogSeries(const std::string& _variable,
+                 const T* _values,
+                 const uint64_t& _index,
+                 const uint64_t& _count) {
+    Write(ncfile_, _variable, {_index}, {_count}, _values);
   }
   /// @brief Setup for unweighted network log
   /// @param[in] _num_nodes Number of nodes in network
@@ -79,6 +154,13 @@ class DataLogger {
   /// @param[in] _num_nodes Number of nodes in network
   /// @param[in] _ticks Number of ticks in simulation
   void WeightedNetwork(const uint16_t& _num_nodes, const uint64_t& _ticks);
+  /// @brief Setup for unweighted network transition log
+  /// @details Each edge that turns on or off is one entry along the "event"
+  /// dimension. Optional snapshots hold the whole graph at a tick, along
+  /// with the number of events logged up to and including that tick.
+  /// @param[in] _num_nodes Number of nodes in network
+  /// @param[in] _ticks Number of ticks in simulation
+  void UnweightedEvents(const uint16_t& _num_nodes, const uint64_t& _ticks);
   /// @brief Logs date and time data
   /// @param[in] _variable NetCDF variable name
   /// @param[in] _values Integer values
@@ -102,6 +184,17 @@ class DataLogger {
   void LogUnweightedGraph(const uint64_t& _tick,
                           const bool* _edges,
                           const uint16_t _num_nodes);
+  /// @brief Logs a snapshot of an unweighted graph
+  /// @param[in] _index Index of the snapshot
+  /// @param[in] _tick Tick of the simulation clock
+  /// @param[in] _num_events Number of events logged so far
+  /// @param[in] _edges Edge flags
+  /// @param[in] _num_nodes Number of nodes in network
+  void LogUnweightedSnapshot(const uint64_t& _index,
+                             const uint64_t& _tick,
+                             const uint64_t& _num_events,
+                             const bool* _edges,
+                             const uint16_t _num_nodes);
   /// @brief Logs weighted graph
   /// @param[in] _tick Tick of the simulation clock
   /// @param[in] _edges Edge weightes
@@ -115,10 +208,150 @@ class DataLogger {
   void LogCommunication();
 
  private:
+  /// @class WriteRequest
+  /// @brief A queued write
+  class WriteRequest {
+   public:
+    /// @brief Destructor
+    virtual ~WriteRequest() {}
+    /// @brief Writes to the file
+    virtual void Write() const = 0;
+  };
+  /// @class WriteRequestTyped
+  /// @brief A queued write that owns a copy of its values
+  template <class T>
+  class WriteRequestTyped : public WriteRequest {
+   public:
+    /// @brief Constructor
+    /// @param[in] _group NetCDF group
+    /// @param[in] _variable NetCDF variable name
+    /// @param[in] _start Start index in each dimension
+    /// @param[in] _count Count of elements in each dimension
+    /// @param[in] _values Array of values (copied)
+    /// @param[in] _size Number of values
+    WriteRequestTyped(const netCDF::NcGroup& _group,
+                      const std::string& _variable,
+                      const std::vector<size_t>& _start,
+                      const std::vector<size_t>& _count,
+                      const T* _values,
+                      const uint64_t& _size)
+        : group_(_group),
+          variable_(_variable),
+          start_(_start),
+          count_(_count),
+          values_(new T[_size]) {
+      std::copy(_values, _values + _size, values_.get());
+    }
+    /// @brief Writes to the file
+    void Write() const {
+      group_.getVar(variable_).putVar(start_, count_, values_.get());
+    }
+
+   private:
+    /// @brief NetCDF group
+    netCDF::NcGroup group_;
+    /// @brief NetCDF variable name
+    std::string variable_;
+    /// @brief Start index in each dimension
+    std::vector<size_t> start_;
+    /// @brief Count of elements in each dimension
+    std::vector<size_t> count_;
+    /// @brief Values
+    std::unique_ptr<T[]> values_;
+  };
+  /// @brief Writes (or queues) a hyperslab of a variable
+  /// @param[in] _group NetCDF group
+  /// @param[in] _variable NetCDF variable name
+  /// @param[in] _start Start index in each dimension
+  /// @param[in] _count Count of elements in each dimension
+  /// @param[in] _values Array of values
+  template <class T>
+  void Write(const netCDF::NcGroup& _group,
+             const std::string& _variable,
+             const std::vector<size_t>& _start,
+             const std::vector<size_t>& _count,
+             const T* _values) {
+    if (queue_depth_ == 0) {
+      std::lock_guard<std::mutex> lock(netcdf_mutex_);
+      _group.getVar(_variable).putVar(_start, _count, _values);
+      return;
+    }
+    uint64_t size = 1;
+    for (auto count : _count) {
+      size *= count;
+    }
+    Enqueue(std::unique_ptr<WriteRequest>(
+        new WriteRequestTyped<T>(_group,
+                                 _variable,
+                                 _start,
+                                 _count,
+                                 _values,
+                                 size)));
+  }
+  /// @brief Defines a 1-D variable chunked along its dimension
+  /// @param[in] _group NetCDF group
+  /// @param[in] _name NetCDF variable name
+  /// @param[in] _type NetCDF type name
+  /// @param[in] _dim NetCDF dimension name
+  /// @returns NetCDF variable
+  netCDF::NcVar AddSeries(const netCDF::NcGroup& _group,
+                          const std::string& _name,
+                          const std::string& _type,
+                          const std::string& _dim) const;
+  /// @brief Defines a [node, time] variable chunked along time
+  /// @param[in] _name NetCDF variable name
+  /// @param[in] _type NetCDF type name
+  void AddMatrix(const std::string& _name, const std::string& _type) const;
+  /// @brief Defines the run-length encoded simulation clock (see
+  /// SimulationClock::Buffer) on an unlimited "step" dimension
+  void AddClock();
+  /// @brief Defines a time dimension (unlimited if the policy says so)
+  /// @param[in] _name NetCDF dimension name
+  /// @param[in] _ticks Number of simulation ticks
+  void AddTimeDim(const std::string& _name, const uint64_t& _ticks);
+  /// @brief Applies the chunk shape and filters of the storage policy
+  /// @details Chunk lengths are at least 1, which NetCDF requires even
+  /// along a zero-length dimension
+  /// @param[in] _variable NetCDF variable
+  /// @param[in] _chunks Chunk shape
+  void Store(const netCDF::NcVar& _variable, std::vector<size_t> _chunks) const;
+  /// @brief Adds a write to the queue, blocking while the queue is full
+  /// @details Rethrows the exception of a failed background write
+  /// @param[in] _request Write request
+  void Enqueue(std::unique_ptr<WriteRequest> _request);
+  /// @brief Throws (and clears) the exception of a failed background write
+  /// @details Call with queue_mutex_ held
+  void Rethrow();
+  /// @brief Writes queued requests until the logger is destroyed
+  void Drain();
+  /// @brief Serializes calls into the NetCDF library across loggers
+  static std::mutex netcdf_mutex_;
   /// @brief NetCDF file
   netCDF::NcFile ncfile_;
   /// @brief List of NetCDF groups
   std::vector<netCDF::NcGroup> groups_;
+  /// @brief Storage policy
+  StoragePolicy storage_;
+  /// @brief Maximum number of queued writes (0 for synchronous)
+  uint64_t queue_depth_;
+  /// @brief Queued writes
+  std::deque<std::unique_ptr<WriteRequest>> queue_;
+  /// @brief Guards the queue
+  std::mutex queue_mutex_;
+  /// @brief Signals a new write or shutdown to the writer
+  std::condition_variable queue_ready_;
+  /// @brief Signals free space in the queue
+  std::condition_variable queue_space_;
+  /// @brief Signals that the queue has been drained
+  std::condition_variable queue_empty_;
+  /// @brief Whether or not the writer is in the middle of a write
+  bool writing_;
+  /// @brief Whether or not the writer should exit once the queue is empty
+  bool stopping_;
+  /// @brief First exception of a background write (nullptr if none)
+  std::exception_ptr error_;
+  /// @brief Writer thread
+  std::thread writer_;
 };
 
 }  // namespace collaborate
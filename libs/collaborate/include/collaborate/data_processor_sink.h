@@ -34,13 +34,13 @@ class DataProcessorSink : public DataProcessor {
   /// @brief Constructor
   DataProcessorSink();
   /// @brief Processes a sensor measurement
-  /// @param[in] _raw_packets List of raw measurement packets
+  /// @param[in] _raw_packets Views of the raw measurement packets
   /// @param[in] _source_index Index of source node
   /// @param[in] _clock Simulation clock
   /// @param[in] _min_list List of minimal suggestions
   /// @param[in] _max_list List of maximum suggestions
   /// @param[in] _feedback List of feedback target node indices
-  void Compute(const std::vector<PacketRaw>& _raw_packets,
+  void Compute(const std::vector<PacketRawView>& _raw_packets,
                const uint16_t& _source_index,
                const SimulationClock& _clock,
                std::vector<Geodetic>* _min_list,
@@ -16,13 +16,21 @@
 #ifndef LIBS_COLLABORATE_INCLUDE_COLLABORATE_EARTH_DATA_H_
 #define LIBS_COLLABORATE_INCLUDE_COLLABORATE_EARTH_DATA_H_
 
-#include <array>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "collaborate/earth.h"
+#include "collaborate/earth_tiles.h"
 #include "collaborate/simulation_clock.h"
+#include "collaborate/util.h"
 
 namespace osse {
 namespace collaborate {
@@ -31,8 +39,63 @@ namespace collaborate {
 /// @brief A map of scientific measurement data
 /// @image html raster/combined.png width=500
 /// @image latex vector/combined.pdf width=\textwidth
+/// @details Frames are shared process-wide: every EarthData that loads the
+/// same (path, time index) holds the same immutable frame, which is freed
+/// once no EarthData holds it. A frame holds every tracked variable (see
+/// Track), read in one pass over the file. The frame after the ones in use
+/// is loaded on a background thread, so crossing into it only swaps
+/// pointers (unless the load has not finished yet). If a tile file (see
+/// EarthTiles::Path) sits next to a NetCDF file, and is not older than it,
+/// it is mapped instead of reading the whole variable.
 class EarthData {
  public:
+  /// @brief Number of rows read per NetCDF call (the library lock is
+  /// released between reads, so loads do not stall loggers for long)
+  static constexpr uint64_t kRowsPerRead = 64;
+  /// @brief Time between data files (seconds)
+  static constexpr uint64_t kResolutionS = 1800;
+  /// @brief Half the spacing of grid rows (meters), the resolution radius
+  /// of a single-cell sample
+  static constexpr double kCellRadiusM = earth::kSemiMajorAxisM
+                                         * earth::kLatIncrementRad / 2;
+  /// @brief In-memory storage of a variable read from NetCDF
+  enum class kStorage {
+    /// 32-bit floats, as read
+    Float,
+    /// 16-bit codes, linear between the slice's minimum and maximum valid
+    /// values (fill, missing, and non-finite values become kFillCode)
+    Quantized,
+    /// IEEE 754 half-precision floats (fill and missing values become NaN)
+    Half
+  };
+  /// @brief Code reserved for fill and missing values (kStorage::Quantized)
+  static constexpr uint16_t kFillCode = std::numeric_limits<uint16_t>::max();
+  /// @brief An immutable map of one variable
+  typedef struct Slice {
+    /// @brief Values, row-major (kStorage::Float, empty if mapped)
+    std::vector<float> values;
+    /// @brief Codes, row-major (kStorage::Quantized or kStorage::Half)
+    std::vector<uint16_t> codes;
+    /// @brief Storage of values or codes
+    kStorage storage;
+    /// @brief Value of one code step (kStorage::Quantized)
+    float scale;
+    /// @brief Value of code 0 (kStorage::Quantized)
+    float offset;
+    /// @brief Mapped tiles (nullptr if read into values or codes)
+    std::unique_ptr<EarthTiles> tiles;
+    /// @brief Summed-area table, (kNumLats + 1) x (kNumLons + 1), built on
+    /// load for variables in TrackFootprint, else on the first footprint
+    /// measurement of the slice (see MeasureFootprint)
+    mutable std::vector<double> sums;
+    /// @brief Guards building the summed-area table once
+    mutable std::once_flag summed;
+  } Slice;
+  /// @brief An immutable frame of measurement data (one file)
+  typedef struct Frame {
+    /// @brief Slices, by variable
+    std::map<std::string, Slice> slices;
+  } Frame;
   /// @brief Constructor
   /// @param[in] _root Root directory path
   explicit EarthData(const std::string& _root);
@@ -41,34 +104,237 @@ class EarthData {
   /// @param[in] _variable Variable in nercdf file
   void Update(const SimulationClock& _clock, const std::string& _variable);
   /// @brief Obtains a data sample at the nearest location on the discrete map
+  /// (or a bilinear interpolation of the nearby samples, see set_bilinear)
+  /// @details Blends the current and next frames if set_temporal is on
   /// @param[in] _latitude_rad Latitude (radians)
   /// @param[in] _longitude_rad Longitude (radians)
   /// @returns The data sample
   float Measure(const double& _latitude_rad,
                 const double& _longitude_rad) const;
-
- private:
-  /// @brief Loads netcdf data into the current data frame
-  /// @param[in] _variable Variable in nercdf file
-  void Buffer(const std::string& _variable);
+  /// @brief Obtains the mean of the data over a footprint
+  /// @details The footprint is the box of grid cells within the radius of
+  /// the nearest cell, so the mean costs O(1) for any radius (a summed-area
+  /// table per slice). Non-finite values count as 0. The table takes 8
+  /// bytes per cell, which is twice a float slice, and building it reads
+  /// the whole slice (every tile of a tile-backed one); see TrackFootprint
+  /// to build it on load. Blends the current and next frames if
+  /// set_temporal is on.
+  /// @param[in] _latitude_rad Latitude (radians)
+  /// @param[in] _longitude_rad Longitude (radians)
+  /// @param[in] _radius_m Footprint radius (meters, Measure if not positive)
+  /// @returns The data sample
+  float MeasureFootprint(const double& _latitude_rad,
+                         const double& _longitude_rad,
+                         const double& _radius_m) const;
+  /// @brief Obtains data samples at many locations (a swath) at once
+  /// @details Same values as MeasureFootprint at each location, with the
+  /// frame lookups and interpolation settings resolved once for the batch
+  /// @param[in] _latitudes_rad Latitudes (radians)
+  /// @param[in] _longitudes_rad Longitudes (radians)
+  /// @param[in] _radii_m Footprint radii (meters, 0 for Measure)
+  /// @param[out] _samples Data samples (resized to the number of locations)
+  void Measure(const std::vector<double>& _latitudes_rad,
+               const std::vector<double>& _longitudes_rad,
+               const std::vector<double>& _radii_m,
+               std::vector<float>* _samples) const;
+  /// @brief Obtains the bilinear interpolation of the four nearby samples
+  /// @details Sample i sits where IndexLatitude (or IndexLongitude) turns
+  /// to i halfway through a cell. Latitude is clamped at the poles and
+  /// longitude wraps around the antimeridian.
+  /// @param[in] _latitude_rad Latitude (radians)
+  /// @param[in] _longitude_rad Longitude (radians)
+  /// @returns The interpolated data sample
+  float MeasureBilinear(const double& _latitude_rad,
+                        const double& _longitude_rad) const;
   /// @brief Obtains the index of the nearest latitude value
+  /// @details The row after the first grid line above the latitude (clamped
+  /// to the last row), as the original grid search returned
   /// @param[in] _latitude_rad Latitude (radians)
   /// @returns Index of the nearest latitude value
-  uint16_t IndexLatitude(const double& _latitude_rad) const;
+  static uint16_t IndexLatitude(const double& _latitude_rad);
   /// @brief Obtains the index of the nearest longitude value
+  /// @details The column after the first grid line east of the longitude
+  /// (clamped to the last column), as the original grid search returned
   /// @param[in] _longitude_rad Longitude (radians)
   /// @returns Index of the nearest longitude value
-  uint16_t IndexLongitude(const double& _longitude_rad) const;
-  /// @brief Finds all regular paths in a directory
+  static uint16_t IndexLongitude(const double& _longitude_rad);
+  /// @brief Finds all NetCDF files in a directory
   /// @param[in] _root Root directory path name
-  /// @returns List of all regular paths in a directory
-  std::vector<std::string> FindDataPaths(const std::string& _root) const;
+  /// @returns Sorted list of all NetCDF files in a directory
+  static std::vector<std::string> FindDataPaths(const std::string& _root);
+  /// @brief Adds a variable to every frame loaded from now on
+  /// @details Sensors track their variable when constructed, so files
+  /// holding several variables (see util/combine.py) are read once
+  /// @param[in] _variable Variable in netcdf file
+  static void Track(const std::string& _variable);
+  /// @brief Adds a variable to every frame loaded from now on, or changes
+  /// how it is stored
+  /// @details Quantized and half-precision slices use half the memory, for
+  /// variables that sensors only threshold. Tile files are always floats.
+  /// @param[in] _variable Variable in netcdf file
+  /// @param[in] _storage In-memory storage
+  static void Track(const std::string& _variable, const kStorage& _storage);
+  /// @brief Builds the summed-area table of a variable as its frames load
+  /// @details Moves the cost of the first footprint measurement of each
+  /// frame to the load, off the simulation thread when prefetched
+  /// @param[in] _variable Variable in netcdf file
+  static void TrackFootprint(const std::string& _variable);
+  /// @brief Set whether or not Measure interpolates in space
+  /// @param[in] _bilinear Whether or not Measure interpolates in space
+  void set_bilinear(const bool& _bilinear) {bilinear_ = _bilinear;}
+  /// @brief Set whether or not Measure interpolates in time
+  /// @details Blends the current file and the next one linearly across
+  /// each kResolutionS interval, instead of jumping at its end
+  /// @param[in] _temporal Whether or not Measure interpolates in time
+  void set_temporal(const bool& _temporal) {temporal_ = _temporal;}
+
+ private:
+  /// @brief Registry key: data path and time index
+  typedef std::pair<std::string, uint64_t> Key;
+  /// @brief Loads the data frames for the current time index
+  /// @param[in] _variable Variable in nercdf file
+  void Buffer(const std::string& _variable);
+  /// @brief Obtains a slice, from the frames held or prefetched if possible
+  /// @param[in] _index Time index
+  /// @param[in] _variable Variable in nercdf file
+  /// @returns The slice (nullptr past the last file)
+  std::shared_ptr<const Slice> Take(const uint64_t& _index,
+                                    const std::string& _variable);
+  /// @brief Starts loading a data frame on a background thread
+  /// @param[in] _index Time index
+  /// @param[in] _variable Variable in nercdf file
+  void Prefetch(const uint64_t& _index, const std::string& _variable);
+  /// @brief Finds a loaded frame in the registry, or loads it
+  /// @details The registry is not locked while loading; a request for a
+  /// file already loading waits for that load. A frame missing the
+  /// variable is replaced by one with every tracked variable.
+  /// @param[in] _key Data path and time index
+  /// @param[in] _variable Variable in netcdf file
+  /// @returns The variable's slice (sharing ownership of its frame)
+  static std::shared_ptr<const Slice> Acquire(const Key& _key,
+                                              const std::string& _variable);
+  /// @brief Reads variables of one file into a new frame
+  /// @param[in] _path NetCDF file path
+  /// @param[in] _variables Variables in netcdf file, and their storage
+  /// @param[in] _footprints Variables to build summed-area tables for
+  /// @returns The frame
+  static std::shared_ptr<Frame> Load(
+      const std::string& _path,
+      const std::map<std::string, kStorage>& _variables,
+      const std::set<std::string>& _footprints);
+  /// @brief Stores values as 16-bit codes
+  /// @param[in] _values Values, row-major
+  /// @param[in] _fills Fill and missing values (_FillValue, missing_value)
+  /// @param[in] _storage kStorage::Quantized or kStorage::Half
+  /// @param[out] _slice Slice (codes, storage, scale, and offset)
+  static void Encode(const std::vector<float>& _values,
+                     const std::vector<float>& _fills,
+                     const kStorage& _storage,
+                     Slice* _slice);
+  /// @brief Obtains the index of a grid line (the cell below a value)
+  /// @param[in] _offset_rad Offset from the first grid line (radians)
+  /// @param[in] _increment_rad Grid spacing (radians)
+  /// @returns Index of the last grid line at or below the value (-1 if none)
+  static int64_t GridLine(const double& _offset_rad,
+                          const double& _increment_rad);
+  /// @brief Obtains a sample of the current (and next) data frames
+  /// @param[in] _bilinear Whether or not to interpolate in space
+  /// @param[in] _latitude_rad Latitude (radians)
+  /// @param[in] _longitude_rad Longitude (radians)
+  /// @returns The data sample
+  float Blend(const bool& _bilinear,
+              const double& _latitude_rad,
+              const double& _longitude_rad) const;
+  /// @brief Obtains a sample of one slice
+  /// @param[in] _slice Slice
+  /// @param[in] _bilinear Whether or not to interpolate in space
+  /// @param[in] _latitude_rad Latitude (radians)
+  /// @param[in] _longitude_rad Longitude (radians)
+  /// @returns The data sample
+  static float Sample(const Slice& _slice,
+                      const bool& _bilinear,
+                      const double& _latitude_rad,
+                      const double& _longitude_rad);
+  /// @brief Obtains the mean of one slice over a footprint
+  /// @param[in] _slice Slice
+  /// @param[in] _latitude_rad Latitude (radians)
+  /// @param[in] _longitude_rad Longitude (radians)
+  /// @param[in] _radius_m Footprint radius (meters)
+  /// @returns The mean
+  static float Footprint(const Slice& _slice,
+                         const double& _latitude_rad,
+                         const double& _longitude_rad,
+                         const double& _radius_m);
+  /// @brief Obtains the sum of a box of grid cells
+  /// @param[in] _sums Summed-area table
+  /// @param[in] _first_row First row
+  /// @param[in] _last_row Last row
+  /// @param[in] _first_column First column
+  /// @param[in] _last_column Last column
+  /// @returns The sum
+  static double BoxSum(const std::vector<double>& _sums,
+                       const uint64_t& _first_row,
+                       const uint64_t& _last_row,
+                       const uint64_t& _first_column,
+                       const uint64_t& _last_column);
+  /// @brief Builds the summed-area table of a slice
+  /// @param[in] _slice Slice
+  static void Summarize(const Slice& _slice);
+  /// @brief Obtains the value of one grid cell
+  /// @param[in] _slice Slice
+  /// @param[in] _row Row (latitude index)
+  /// @param[in] _column Column (longitude index)
+  /// @returns The value (NaN for a fill or missing value)
+  static float Cell(const Slice& _slice,
+                    const uint64_t& _row,
+                    const uint64_t& _column) {
+    if (_slice.tiles != nullptr) {
+      return _slice.tiles->At(_row, _column);
+    }
+    uint64_t index = util::Index(_row, _column, earth::kNumLons);
+    switch (_slice.storage) {
+    case(kStorage::Quantized):
+      if (_slice.codes[index] == kFillCode) {
+        return std::numeric_limits<float>::quiet_NaN();
+      }
+      return _slice.codes[index] * _slice.scale + _slice.offset;
+    case(kStorage::Half):
+      return util::FloatFromHalf(_slice.codes[index]);
+    default:
+      return _slice.values[index];
+    }
+  }
   /// @brief The list of netcdf files
   const std::vector<std::string> data_paths_;
   /// @brief Current data-set's index
   uint64_t current_index_;
-  /// @brief Current data set
-  std::array<float, earth::kNumPositions> kData_;
+  /// @brief Whether or not Measure interpolates in space
+  bool bilinear_;
+  /// @brief Whether or not Measure interpolates in time
+  bool temporal_;
+  /// @brief Weight of the next data set (0 to 1, if interpolating in time)
+  double weight_;
+  /// @brief Current data set (nullptr before the first load)
+  std::shared_ptr<const Slice> data_;
+  /// @brief Next data set (nullptr unless interpolating in time)
+  std::shared_ptr<const Slice> later_;
+  /// @brief Index of the next data set
+  uint64_t later_index_;
+  /// @brief Index of the data set being prefetched
+  uint64_t next_index_;
+  /// @brief Data set being prefetched (invalid if none)
+  std::future<std::shared_ptr<const Slice>> next_;
+  /// @brief Frames held by any EarthData
+  static std::map<Key, std::weak_ptr<const Frame>> frames_;
+  /// @brief Loads in flight, which later requests for the same file await
+  static std::map<Key, std::shared_future<std::shared_ptr<const Frame>>>
+      loading_;
+  /// @brief Variables to load into each frame, and their storage
+  static std::map<std::string, kStorage> variables_;
+  /// @brief Variables whose summed-area tables are built on load
+  static std::set<std::string> footprints_;
+  /// @brief Guards the registry, loads in flight, and tracked variables
+  static std::mutex frames_mutex_;
 };
 
 }  // namespace collaborate
@@ -0,0 +1,106 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef LIBS_COLLABORATE_INCLUDE_COLLABORATE_EARTH_TILES_H_
+#define LIBS_COLLABORATE_INCLUDE_COLLABORATE_EARTH_TILES_H_
+
+#include <cstdint>
+#include <string>
+
+namespace osse {
+namespace collaborate {
+
+/// @class EarthTiles
+/// @brief A memory-mapped, tiled copy of one EarthData slice
+/// @details The grid is stored uncompressed as square tiles of
+/// kTileSize x kTileSize floats, row-major within each tile and tiles
+/// row-major across the grid (edge tiles are zero-padded). Sampling a
+/// location only pages in the tile under it, and processes reading the
+/// same file share the page cache. Convert builds a file from a NetCDF
+/// slice.
+class EarthTiles {
+ public:
+  /// @brief File identifier
+  static constexpr char kMagic[8] = "OSSETIL";
+  /// @brief File format version
+  static constexpr uint32_t kVersion = 1;
+  /// @brief Tile edge length (cells)
+  static constexpr uint64_t kTileSize = 64;
+  /// @brief Offset of the first tile (bytes)
+  static constexpr uint64_t kAlignment = 4096;
+  /// @brief File header
+  typedef struct Header {
+    /// @brief File identifier
+    char magic[8];
+    /// @brief File format version
+    uint32_t version;
+    /// @brief Tile edge length (cells)
+    uint32_t tile_size;
+    /// @brief Number of grid rows (latitudes)
+    uint64_t num_lats;
+    /// @brief Number of grid columns (longitudes)
+    uint64_t num_lons;
+    /// @brief Reserved
+    uint64_t reserved[4];
+  } Header;
+  /// @brief Constructor (maps the file read-only)
+  /// @param[in] _path Tile file path
+  explicit EarthTiles(const std::string& _path);
+  /// @brief Destructor (unmaps the file)
+  ~EarthTiles();
+  /// @brief Obtains the value of one grid cell
+  /// @param[in] _row Row (latitude index)
+  /// @param[in] _column Column (longitude index)
+  /// @returns The value
+  float At(const uint64_t& _row, const uint64_t& _column) const {
+    uint64_t tile = (_row / kTileSize) * tiles_per_row_ + _column / kTileSize;
+    return tiles_[(tile * kTileSize + _row % kTileSize) * kTileSize
+                  + _column % kTileSize];
+  }
+  /// @brief Get whether or not the file is mapped (and matches the grid)
+  /// @returns Whether or not the file is mapped
+  bool valid() const {return tiles_ != nullptr;}
+  /// @brief Obtains the tile file path for a NetCDF file and variable
+  /// @param[in] _netcdf_path NetCDF file path
+  /// @param[in] _variable Variable in netcdf file
+  /// @returns The NetCDF path with its extension replaced by
+  /// ".<variable>.tiles"
+  static std::string Path(const std::string& _netcdf_path,
+                          const std::string& _variable);
+  /// @brief Writes the first time slice of a NetCDF variable as tiles
+  /// @param[in] _netcdf_path NetCDF file path
+  /// @param[in] _variable Variable in netcdf file
+  /// @param[in] _tiles_path Tile file sink path
+  /// @returns Whether or not the tile file was written (a failed write
+  /// removes it)
+  static bool Convert(const std::string& _netcdf_path,
+                      const std::string& _variable,
+                      const std::string& _tiles_path);
+
+ private:
+  /// @brief Mapped file (nullptr if not mapped)
+  void* data_;
+  /// @brief Size of the mapped file (bytes)
+  uint64_t size_;
+  /// @brief First tile in the mapped file (nullptr if not mapped)
+  const float* tiles_;
+  /// @brief Number of tiles across the grid
+  uint64_t tiles_per_row_;
+};
+
+}  // namespace collaborate
+}  // namespace osse
+
+#endif  // LIBS_COLLABORATE_INCLUDE_COLLABORATE_EARTH_TILES_H_
@@ -16,24 +16,82 @@
 #ifndef LIBS_COLLABORATE_INCLUDE_COLLABORATE_EVENT_LOGGER_H_
 #define LIBS_COLLABORATE_INCLUDE_COLLABORATE_EVENT_LOGGER_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "spdlog/async_logger.h"
+#include "spdlog/details/thread_pool.h"
 #include "spdlog/fmt/ostr.h"
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/spdlog.h"
 
+#include "collaborate/simulation_clock.h"
+
 namespace osse {
 namespace collaborate {
 
 /// @class EventLogger
 /// @brief An interface to the spdlog logger
+/// @details An asynchronous logger formats and writes events on a single
+/// background thread (so events stay in order), and the caller only queues
+/// them. Events below the logger's level are dropped before formatting.
+/// Typed events (transfers, predictions, routes, and measurements) can also
+/// be written as fixed-size binary records, with text rendering optional.
 class EventLogger {
  public:
+  /// @brief Types of event records
+  enum class kEvent : uint8_t {
+    TransferStart,
+    TransferEnd,
+    TransferFail,
+    Prediction,
+    Route,
+    RouteHop,
+    MeasurementStart
+  };
+  /// @brief A fixed-size (24-byte) event record
+  /// @details The meaning of node, peer, and value depends on the type:
+  /// transfers have the transmitter, receiver, and 0; predictions have the
+  /// source, destination, and time limit (s); routes have the source,
+  /// destination, and number of hops, followed by one RouteHop record per
+  /// hop with the hop's receiver, hop number, and contact time (s);
+  /// measurements have the node, return node, and 0.
+  typedef struct EventRecord {
+    /// @brief Elapsed simulation time (seconds)
+    uint64_t elapsed_s;
+    /// @brief Type-dependent value
+    uint64_t value;
+    /// @brief Node
+    uint16_t node;
+    /// @brief Peer node
+    uint16_t peer;
+    /// @brief Event type (kEvent)
+    uint8_t type;
+    /// @brief Padding
+    uint8_t reserved[3];
+  } EventRecord;
   /// @brief Constructor
   /// @param[in] _path File sink path
   explicit EventLogger(const std::string& _path);
+  /// @brief Constructor (optional console sink)
+  /// @param[in] _path File sink path
+  /// @param[in] _console Whether or not to also log to the console
+  EventLogger(const std::string& _path, const bool& _console);
+  /// @brief Constructor (asynchronous)
+  /// @param[in] _path File sink path
+  /// @param[in] _console Whether or not to also log to the console
+  /// @param[in] _queue_size Maximum number of queued events
+  /// @param[in] _overflow Whether a full queue blocks or drops old events
+  EventLogger(const std::string& _path,
+              const bool& _console,
+              const size_t& _queue_size,
+              const spdlog::async_overflow_policy& _overflow);
   /// @brief Initialize the event logger's behavor
   /// @param[in] _level Base level for logging
   /// @param[in] _console_level Level for console logging
@@ -41,17 +99,86 @@ class EventLogger {
   void Initialize(const std::string& _level,
                   const std::string& _console_level,
                   const bool& _utc);
+  /// @brief Opens a file for binary event records (replacing it)
+  /// @param[in] _path Record file path
+  void OpenRecords(const std::string& _path);
+  /// @brief Set whether typed events are also rendered as text
+  /// @param[in] _render Whether or not to render typed events as text
+  void set_render(const bool& _render) {render_ = _render;}
+  /// @brief Records the start of a transfer
+  /// @param[in] _clock Simulation clock
+  /// @param[in] _tx_index Transmitting node
+  /// @param[in] _rx_index Receiving node
+  void TransferStart(const SimulationClock& _clock,
+                     const uint16_t& _tx_index,
+                     const uint16_t& _rx_index);
+  /// @brief Records the end of a transfer
+  /// @param[in] _clock Simulation clock
+  /// @param[in] _tx_index Transmitting node
+  /// @param[in] _rx_index Receiving node
+  /// @param[in] _success Whether or not the transfer succeeded
+  void TransferEnd(const SimulationClock& _clock,
+                   const uint16_t& _tx_index,
+                   const uint16_t& _rx_index,
+                   const bool& _success);
+  /// @brief Records a predicted visit to route towards
+  /// @param[in] _clock Simulation clock
+  /// @param[in] _source Source node
+  /// @param[in] _destination Destination node
+  /// @param[in] _limit_s Time limit (seconds)
+  void Prediction(const SimulationClock& _clock,
+                  const uint16_t& _source,
+                  const uint16_t& _destination,
+                  const uint64_t& _limit_s);
+  /// @brief Records a route that was found
+  /// @param[in] _clock Simulation clock
+  /// @param[in] _source Source node
+  /// @param[in] _route Receiving node and contact time (s) of each hop
+  void Route(const SimulationClock& _clock,
+             const uint16_t& _source,
+             const std::vector<std::pair<uint16_t, uint64_t>>& _route);
+  /// @brief Records the start of a measurement
+  /// @param[in] _clock Simulation clock
+  /// @param[in] _node Measuring node
+  /// @param[in] _return_index Node the measurement is returned to
+  /// @param[in] _variable Measured variable
+  void MeasurementStart(const SimulationClock& _clock,
+                        const uint16_t& _node,
+                        const uint16_t& _return_index,
+                        const std::string& _variable);
   /// @brief Get the spdlog
   /// @returns log_ Pointer to spdlog
   spdlog::logger* log() {return log_.get();}
 
  private:
-  /// @brief Console sink
+  /// @brief Writes a binary event record (if a record file is open)
+  /// @param[in] _type Event type
+  /// @param[in] _clock Simulation clock
+  /// @param[in] _node Node
+  /// @param[in] _peer Peer node
+  /// @param[in] _value Type-dependent value
+  void Write(const kEvent& _type,
+             const SimulationClock& _clock,
+             const uint16_t& _node,
+             const uint16_t& _peer,
+             const uint64_t& _value);
+  /// @brief Creates the console sink (if requested) and lists the sinks
+  /// @param[in] _console Whether or not to also log to the console
+  /// @returns Sinks
+  std::vector<spdlog::sink_ptr> Sinks(const bool& _console);
+  /// @brief Console sink (nullptr if disabled)
   std::shared_ptr<spdlog::sinks::stdout_color_sink_mt> console_;
   /// @brief File sink
   std::shared_ptr<spdlog::sinks::basic_file_sink_mt> file_;
+  /// @brief Background thread and queue (nullptr if synchronous)
+  /// @details Destroyed after the logger, which writes out queued events
+  std::shared_ptr<spdlog::details::thread_pool> thread_pool_;
   /// @brief Multi-sink
-  std::unique_ptr<spdlog::logger> log_;
+  std::shared_ptr<spdlog::logger> log_;
+  /// @brief Binary event records
+  std::ofstream records_;
+  /// @brief Whether or not typed events are rendered as text
+  bool render_;
 };
 
 }  // namespace collaborate
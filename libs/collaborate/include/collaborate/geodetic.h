@@ -141,30 +141,15 @@ class Geodetic {
   const double& altitude_m() const {return altitude_m_;}
 
  private:
-  /// @brief Calculate latitude from position and current time
+  /// @brief Converts a position to latitude, longitude, and altitude
+  /// @details One SGP4 geodetic conversion for all three coordinates
   /// @param[in] _position_m_rad Position of node (meters and radians)
   /// @param[in] _clock Simulation clock
   /// @param[in] _offset_s Offset from current time (seconds)
-  /// @returns The latitude (radians)
-  double CalculateLatitudeRad(const Vector& _position_m_rad,
-                              const SimulationClock& _clock,
-                              const uint64_t& _offset_s) const;
-  /// @brief Calculate longitude from position and current time
-  /// @param[in] _position_m_rad Position of node (meters and radians)
-  /// @param[in] _clock Simulation clock
-  /// @param[in] _offset_s Offset from current time (seconds)
-  /// @returns The longitude (radians)
-  double CalculateLongitudeRad(const Vector& _position_m_rad,
-                               const SimulationClock& _clock,
-                               const uint64_t& _offset_s) const;
-  /// @brief Calculate alttitude from position and current time
-  /// @param[in] _position_m_rad Position of node (meters and radians)
-  /// @param[in] _clock Simulation clock
-  /// @param[in] _offset_s Offset from current time (seconds)
-  /// @returns The altitude (meters)
-  double CalculateAltitudeM(const Vector& _position_m_rad,
-                            const SimulationClock& _clock,
-                            const uint64_t& _offset_s) const;
+  /// @returns Array containing latitude, longitude, and altitude
+  static std::array<double, 3> Convert(const Vector& _position_m_rad,
+                                       const SimulationClock& _clock,
+                                       const uint64_t& _offset_s);
   /// @brief Latitude (radians)
   double latitude_rad_;
   /// @brief Longitude (radians)
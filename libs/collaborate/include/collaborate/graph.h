@@ -13,7 +13,6 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
-#include <cmath>
 #include <cstdint>
 #include <string>
 
@@ -29,23 +28,27 @@ namespace collaborate {
 /// @brief Abstract graph
 class Graph {
  public:
-  /// @brief Maximum number of nodes
-  static constexpr uint16_t kMaxNodes = 200;
-  /// @brief Maximum size of of a graph
-  static constexpr uint16_t kSize = std::pow(kMaxNodes, 2);
   /// @brief Constructor
   /// @param[in] _data_log Data logger
   explicit Graph(DataLogger* _data_log);
   /// @brief Writes graph to a binary file
   /// @param[in] _num_nodes Number of nodes (rows and columns)
   /// @param[in] _tick The simulation clock tick
-  virtual void Log(const uint16_t& _num_nodes, const uint64_t& _tick) const = 0;
+  virtual void Log(const uint16_t& _num_nodes, const uint64_t& _tick) = 0;
   /// @brief Clears all edges
   virtual void Clear() = 0;
+  /// @brief Changes the number of nodes, keeping edges between the survivors
+  /// @param[in] _num_nodes Number of nodes (rows and columns)
+  virtual void Resize(const uint16_t& _num_nodes) = 0;
+  /// @brief Get number of nodes
+  /// @returns num_nodes_ Number of nodes (rows and columns)
+  const uint16_t& num_nodes() const {return num_nodes_;}
 
  protected:
   /// @brief Data logger
   DataLogger* data_log_;
+  /// @brief Number of nodes (rows and columns)
+  uint16_t num_nodes_;
 };
 
 }  // namespace collaborate
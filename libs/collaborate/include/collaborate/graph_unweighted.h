@@ -17,7 +17,6 @@
 #define LIBS_COLLABORATE_INCLUDE_COLLABORATE_GRAPH_UNWEIGHTED_H_
 
 #include <cstdint>
-#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -47,15 +46,28 @@ namespace collaborate {
 /// \\ n_N n_0 & n_N n_1 & \dots &  n_N n_{N-1} & 0
 /// \end{bmatrix}
 /// \f]
+/// Edges are bit-packed: each row is a run of 64-bit words, so the matrix of
+/// an N-node graph occupies N * ceil(N / 64) words. The graph grows when an
+/// edge is set beyond the current number of nodes.
+///
+/// By default Log writes the whole matrix every tick. A graph constructed with
+/// a snapshot interval instead logs only the edges that changed since the last
+/// call (see DataLogger::UnweightedEvents).
 class GraphUnweighted : public Graph {
  public:
+  /// @brief Number of edges per word
+  static constexpr uint16_t kWordBits = 64;
   /// @brief Constructor
   /// @param[in] _data_log Data logger
   explicit GraphUnweighted(DataLogger* _data_log);
+  /// @brief Constructor (transition log)
+  /// @param[in] _data_log Data logger
+  /// @param[in] _snapshot_ticks Ticks between full snapshots (0 for none)
+  GraphUnweighted(DataLogger* _data_log, const uint64_t& _snapshot_ticks);
   /// @brief Writes unweighted graph to a binary file
   /// @param[in] _num_nodes Number of nodes (rows and columns)
   /// @param[in] _tick The simulation clock tick
-  void Log(const uint16_t& _num_nodes, const uint64_t& _tick) const;
+  void Log(const uint16_t& _num_nodes, const uint64_t& _tick);
   /// @brief Sets the edge at a row and a column to
   /// @param[in] _row Row
   /// @param[in] _col Column
@@ -72,8 +84,34 @@ class GraphUnweighted : public Graph {
   /// @returns Set of transmitters
   std::set<uint16_t> GetRow(const uint16_t& _row,
                             const uint16_t& _num_nodes) const;
+  /// @brief Gets the neighbors of a node in ascending order
+  /// @param[in] _row Row
+  /// @returns Columns with an edge
+  std::vector<uint16_t> Neighbors(const uint16_t& _row) const;
+  /// @brief Counts the edges in a row
+  /// @param[in] _row Row
+  /// @returns Number of edges
+  uint16_t Degree(const uint16_t& _row) const;
+  /// @brief Counts the neighbors two nodes share
+  /// @param[in] _row_a First row
+  /// @param[in] _row_b Second row
+  /// @returns Number of common neighbors
+  uint16_t CommonNeighbors(const uint16_t& _row_a,
+                           const uint16_t& _row_b) const;
+  /// @brief Finds the nodes reachable from a node within a number of hops
+  /// @param[in] _row Starting row
+  /// @param[in] _hops Maximum number of hops
+  /// @returns Bit-packed row of reachable nodes (including the start)
+  std::vector<uint64_t> Reach(const uint16_t& _row,
+                              const uint16_t& _hops) const;
+  /// @brief Checks whether every node can reach node zero
+  /// @returns Whether or not the graph is connected
+  bool Connected() const;
   /// @brief Sets all edges to false
   void Clear();
+  /// @brief Changes the number of nodes, keeping edges between the survivors
+  /// @param[in] _num_nodes Number of nodes (rows and columns)
+  void Resize(const uint16_t& _num_nodes);
   /// @brief The route is copied into the graph
   /// @param[in] _route Route
   void TransferRoute(const std::vector<uint16_t>& _route);
@@ -94,10 +132,44 @@ class GraphUnweighted : public Graph {
   bool Prim(const GraphWeighted& _weighted, const uint16_t& _num_nodes);
 
  private:
-  /// @brief Underlying adjacency attitude_matrix
-  typedef std::array<bool, Graph::kSize> Edges;
-  /// @brief Unweighted edges
-  std::unique_ptr<Edges> edges_;
+  /// @brief Copies bit-packed rows into a layout for a new number of nodes
+  /// @param[in] _bits Rows in the current layout
+  /// @param[in] _num_nodes New number of nodes
+  /// @param[in] _words_per_row New number of words in each row
+  /// @returns Rows in the new layout
+  std::vector<uint64_t> Repack(const std::vector<uint64_t>& _bits,
+                               const uint16_t& _num_nodes,
+                               const uint64_t& _words_per_row) const;
+  /// @brief Writes the edges that changed since the last call
+  /// @param[in] _num_nodes Number of nodes (rows and columns)
+  /// @param[in] _tick The simulation clock tick
+  void LogEvents(const uint16_t& _num_nodes, const uint64_t& _tick);
+  /// @brief Fills a row-major matrix of edge flags
+  /// @param[in] _num_nodes Number of nodes (rows and columns)
+  /// @param[out] _edges Edge flags
+  void Dense(const uint16_t& _num_nodes, bool* _edges) const;
+  /// @brief Unweighted edges (row-major, bit-packed)
+  std::vector<uint64_t> edges_;
+  /// @brief Number of words in each row
+  uint64_t words_per_row_;
+  /// @brief Whether or not to log transitions instead of the whole matrix
+  bool events_;
+  /// @brief Ticks between full snapshots (0 for none)
+  uint64_t snapshot_ticks_;
+  /// @brief Edges as of the last transition log (same layout as edges_)
+  std::vector<uint64_t> logged_;
+  /// @brief Number of transitions written
+  uint64_t num_events_;
+  /// @brief Number of snapshots written
+  uint64_t num_snapshots_;
+  /// @brief Transition ticks
+  std::vector<uint64_t> event_time_;
+  /// @brief Transition rows
+  std::vector<uint16_t> event_rx_;
+  /// @brief Transition columns
+  std::vector<uint16_t> event_tx_;
+  /// @brief Transition directions (1 for on, 0 for off)
+  std::vector<int8_t> event_on_;
 };
 
 }  // namespace collaborate
@@ -16,10 +16,9 @@
 #ifndef LIBS_COLLABORATE_INCLUDE_COLLABORATE_GRAPH_WEIGHTED_H_
 #define LIBS_COLLABORATE_INCLUDE_COLLABORATE_GRAPH_WEIGHTED_H_
 
-#include <array>
 #include <cstdint>
-#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "collaborate/data_logger.h"
@@ -44,19 +43,26 @@ namespace collaborate {
 /// \\ n_N n_0 & n_N n_1 & \dots &  n_N n_{N-1} & 0
 /// \end{bmatrix}
 /// \f]
+/// Only nonzero edges are stored, as one adjacency list per row, so memory
+/// follows the number of lines of sight rather than the square of the number
+/// of nodes. The graph grows when an edge is set beyond the current number of
+/// nodes.
 class GraphWeighted : public Graph {
  public:
-  /// @brief Underlying adjacency attitude_matrix
-  typedef std::array<double, Graph::kSize> Edges;
+  /// @brief Nonzero edges of one row (column, weight)
+  typedef std::vector<std::pair<uint16_t, double>> Row;
   /// @brief Constructor
   /// @param[in] _data_log Data logger
   explicit GraphWeighted(DataLogger* _data_log);
   /// @brief Sets all edges to 0.0
   void Clear();
+  /// @brief Changes the number of nodes, keeping edges between the survivors
+  /// @param[in] _num_nodes Number of nodes (rows and columns)
+  void Resize(const uint16_t& _num_nodes);
   /// @brief Writes the weighted graph to a binary file
   /// @param[in] _num_nodes Number of nodes (rows and columns)
   /// @param[in] _tick The simulation clock tick
-  void Log(const uint16_t& _num_nodes, const uint64_t& _tick) const;
+  void Log(const uint16_t& _num_nodes, const uint64_t& _tick);
   /// @brief Sets the edge at a row and a column to
   /// @param[in] _row Row
   /// @param[in] _col Column
@@ -69,15 +75,45 @@ class GraphWeighted : public Graph {
   /// @param[in] _col Column
   /// @returns Value
   double GetEdge(const uint16_t& _row, const uint16_t& _col) const;
+  /// @brief Gets the nonzero edges of a row
+  /// @param[in] _row Row
+  /// @returns Nonzero edges (column, weight)
+  const Row& GetRow(const uint16_t& _row) const {return edges_[_row];}
   /// @brief Uses Dijkstra's algorithm to find shortest path between two nodes
   /// @param[in] _start Beginning index
   /// @param[in] _end End index
   /// @returns Shortest path between the nodes
   std::vector<uint16_t> Dijkstra(const uint16_t& _start, const uint16_t& _end);
+  /// @brief Finds the shortest path length from one node to every node
+  /// @param[in] _start Beginning index
+  /// @returns Path lengths (maximum double where unreachable)
+  std::vector<double> Distances(const uint16_t& _start) const;
+  /// @brief Finds the shortest path length between every pair of nodes
+  /// @details Runs Dijkstra's algorithm from each node, with the sources
+  /// split between threads.
+  /// @param[in] _num_threads Number of threads (0 for the hardware count)
+  /// @returns Row-major path lengths (0.0 on the diagonal and unreachable)
+  std::vector<double> AllPairs(const uint16_t& _num_threads) const;
 
-
-  /// @brief Weighted edges
-  std::unique_ptr<Edges> edges_;
+ private:
+  /// @brief Runs Dijkstra's algorithm with an indexed heap
+  /// @param[in] _start Beginning index
+  /// @param[in] _end End index (search stops once it is settled)
+  /// @param[out] _dist Path lengths
+  /// @param[out] _parent Previous node on each shortest path
+  void ShortestPaths(const uint16_t& _start,
+                     const uint16_t& _end,
+                     std::vector<double>* _dist,
+                     std::vector<uint16_t>* _parent) const;
+  /// @brief Fills the all-pairs rows for a range of sources
+  /// @param[in] _first First source
+  /// @param[in] _last One past the last source
+  /// @param[out] _lengths Row-major path lengths
+  void AllPairsRows(const uint16_t& _first,
+                    const uint16_t& _last,
+                    std::vector<double>* _lengths) const;
+  /// @brief Weighted edges (one adjacency list per row)
+  std::vector<Row> edges_;
 };
 
 }  // namespace collaborate
@@ -0,0 +1,74 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef LIBS_COLLABORATE_INCLUDE_COLLABORATE_INDEXED_HEAP_H_
+#define LIBS_COLLABORATE_INCLUDE_COLLABORATE_INDEXED_HEAP_H_
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace osse {
+namespace collaborate {
+
+/// @class IndexedHeap
+/// @brief Binary min-heap of node indices keyed by a priority
+/// @details Each node appears at most once. Its position in the heap is
+/// tracked, so lowering the priority of a queued node sifts it in place
+/// instead of pushing a duplicate entry.
+class IndexedHeap {
+ public:
+  /// @brief Constructor
+  /// @param[in] _num_nodes Number of nodes (largest index plus one)
+  explicit IndexedHeap(const uint16_t& _num_nodes);
+  /// @brief Whether or not the heap is empty
+  /// @returns Whether or not the heap is empty
+  bool Empty() const {return heap_.empty();}
+  /// @brief Whether or not a node is queued
+  /// @param[in] _node Node index
+  /// @returns Whether or not the node is queued
+  bool Contains(const uint16_t& _node) const;
+  /// @brief Queues a node, or lowers its priority if already queued
+  /// @param[in] _node Node index
+  /// @param[in] _priority Priority (lower is popped first)
+  void Push(const uint16_t& _node, const double& _priority);
+  /// @brief Removes the node with the lowest priority
+  /// @returns Node index
+  uint16_t Pop();
+
+ private:
+  /// @brief Position marking a node that is not queued
+  static constexpr uint64_t kAbsent = std::numeric_limits<uint64_t>::max();
+  /// @brief Moves an entry towards the root
+  /// @param[in] _position Position in the heap
+  void SiftUp(uint64_t _position);
+  /// @brief Moves an entry towards the leaves
+  /// @param[in] _position Position in the heap
+  void SiftDown(uint64_t _position);
+  /// @brief Swaps two entries and updates their positions
+  /// @param[in] _a First position
+  /// @param[in] _b Second position
+  void Swap(const uint64_t& _a, const uint64_t& _b);
+  /// @brief Heap entries (priority, node)
+  std::vector<std::pair<double, uint16_t>> heap_;
+  /// @brief Position of each node in the heap
+  std::vector<uint64_t> position_;
+};
+
+}  // namespace collaborate
+}  // namespace osse
+
+#endif  // LIBS_COLLABORATE_INCLUDE_COLLABORATE_INDEXED_HEAP_H_
@@ -0,0 +1,106 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef LIBS_COLLABORATE_INCLUDE_COLLABORATE_MEASUREMENT_LOGGER_H_
+#define LIBS_COLLABORATE_INCLUDE_COLLABORATE_MEASUREMENT_LOGGER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "collaborate/data_logger.h"
+
+namespace osse {
+namespace collaborate {
+
+/// @class MeasurementLogger
+/// @brief A single ragged-array log for every measurement of one variable
+/// @details Completed measurements are appended to in-memory buffers and
+/// written as CF contiguous ragged arrays: the "obs" dimension holds every
+/// sample, and "row_size" holds the number of samples in each measurement.
+class MeasurementLogger {
+ public:
+  /// @brief Number of buffered samples that triggers a write
+  static constexpr uint64_t kFlushSamples = 100000;
+  /// @brief A buffer for logged measurement samples
+  typedef struct LogBuffer {
+    /// @brief Elapsed time (seconds)
+    std::vector<uint64_t> elapsed_s;
+    /// @brief Year
+    std::vector<int> year;
+    /// @brief Month
+    std::vector<int> month;
+    /// @brief Day
+    std::vector<int> day;
+    /// @brief Hour
+    std::vector<int> hour;
+    /// @brief Minute
+    std::vector<int> minute;
+    /// @brief Second
+    std::vector<int> second;
+    /// @brief Microsecond
+    std::vector<int> microsecond;
+    /// @brief Latitude (radians)
+    std::vector<double> latitude_rad;
+    /// @brief Longitude (radians)
+    std::vector<double> longitude_rad;
+    /// @brief Altitude (meters)
+    std::vector<double> altitude_m;
+    /// @brief Meaurement
+    std::vector<double> measurement;
+    /// @brief Measurement resolution (m)
+    std::vector<double> resolution_m;
+    /// @brief Node index
+    std::vector<uint16_t> index;
+  } LogBuffer;
+  /// @brief Constructor
+  /// @param[in] _path File sink path
+  explicit MeasurementLogger(const std::string& _path);
+  /// @brief Destructor (writes any buffered measurements)
+  ~MeasurementLogger();
+  /// @brief Appends a completed measurement
+  /// @param[in] _samples Samples of the measurement
+  /// @param[in] _elapsed_s Completion time (seconds)
+  /// @param[in] _node_index Index of the measuring node
+  void Append(const LogBuffer& _samples,
+              const uint64_t& _elapsed_s,
+              const uint16_t& _node_index);
+  /// @brief Writes buffered measurements to file
+  void Flush();
+  /// @brief Get number of measurements written
+  /// @returns num_measurements_ Number of measurements written
+  const uint64_t& num_measurements() const {return num_measurements_;}
+
+ private:
+  /// @brief Data log
+  DataLogger data_log_;
+  /// @brief Buffered samples
+  LogBuffer buffer_;
+  /// @brief Buffered number of samples per measurement
+  std::vector<uint64_t> row_size_;
+  /// @brief Buffered completion times (seconds)
+  std::vector<uint64_t> complete_s_;
+  /// @brief Buffered measuring node indices
+  std::vector<uint16_t> node_;
+  /// @brief Number of samples written
+  uint64_t num_samples_;
+  /// @brief Number of measurements written
+  uint64_t num_measurements_;
+};
+
+}  // namespace collaborate
+}  // namespace osse
+
+#endif  // LIBS_COLLABORATE_INCLUDE_COLLABORATE_MEASUREMENT_LOGGER_H_
@@ -64,6 +64,25 @@ class Node {
     /// @brief Number of neighbors
     uint16_t num_neighbors_;
   } PartialLog;
+  /// @brief Parameters to obtain for a log (the rest are left unset)
+  typedef struct LogMask {
+    /// @brief Index (always obtained, since it identifies the node)
+    bool index_;
+    /// @brief Constellation
+    bool constellation_;
+    /// @brief Operation mode
+    bool mode_;
+    /// @brief Latitude, longitude, and altitude
+    bool position_;
+    /// @brief Battery energy stored
+    bool energy_;
+    /// @brief Charging status
+    bool charging_;
+    /// @brief Solar panel effective area
+    bool area_;
+    /// @brief Number of neighbors
+    bool num_neighbors_;
+  } LogMask;
   /// @brief Number of simulation increments in a single data log
   static constexpr int kLogBufferSize = 1000;
   /// @brief A buffer for logged node data
@@ -129,6 +148,17 @@ class Node {
               const bool& _charge,
               const bool& _power_update,
               const bool& _communicate);
+  /// @brief Updates the measurements of every node as one swath
+  /// @details Equivalent to Update with only _measure set for each node, but
+  /// the sensing interfaces are sampled together (see
+  /// SubsystemSensing::UpdateSwath)
+  /// @param[in] _clock Simulation clock
+  /// @param[in] _nodes Nodes
+  static void UpdateMeasurements(const SimulationClock& _clock,
+                                 const std::vector<Node*>& _nodes);
+  /// @brief Update power management
+  /// @param[in] _charge Whether to charge the battery
+  void UpdatePower(const bool& _charge);
   /// @brief Adds a measurement to the list of planned measurements
   /// @param[in] _start_s Start time (seconds)
   /// @param[in] _return_index The index of the informer node
@@ -143,13 +173,22 @@ class Node {
   void MoveSensorDataToCommBuffer();
   /// @brief Buffers entire data frame into the data log
   void BufferDataLog();
+  /// @brief Obtains the parameters logged for the current tick
+  /// @param[out] _log Node parameters
+  void ObtainLog(PartialLog* _log) const;
+  /// @brief Obtains selected parameters logged for the current tick
+  /// @param[in] _mask Parameters to obtain
+  /// @param[out] _log Node parameters
+  void ObtainLog(const LogMask& _mask, PartialLog* _log) const;
   /// @brief Buffers remainder data fram into the data log
   void Flush();
   /// @brief Sets the data buffer of the communication interface
   /// @param[in] _comm_buffer The data buffer for the communication interface
+  /// (moved in)
   void SetCommBuffer(std::vector<uint8_t> _comm_buffer);
   /// @brief Sets the data buffer of the sensing interface
   /// @param[in] _sensing_buffer The data buffer for the sensing interface
+  /// (moved in)
   void SetSensingBuffer(std::vector<uint8_t> _sensing_buffer);
   /// @brief Erases the data buffer of the communication interface
   void EraseCommBuffer();
@@ -157,10 +196,14 @@ class Node {
   void EraseSensingBuffer();
   /// @brief Gets the data buffer of the communication interface
   /// @returns  Data buffer for the communication interface
-  std::vector<uint8_t> GetCommBuffer();
+  const std::vector<uint8_t>& GetCommBuffer() const;
   /// @brief Gets the data buffer of the sensing interface
   /// @returns Data buffer for the sensing interface
-  std::vector<uint8_t> GetSensingBuffer();
+  const std::vector<uint8_t>& GetSensingBuffer() const;
+  /// @brief Hands over the data buffer of the communication interface
+  /// without copying it
+  /// @returns Data buffer for the communication interface (leaving it empty)
+  std::vector<uint8_t> ReleaseCommBuffer();
   /// @brief Set mode of operation
   /// @param[in] _mode Mode of operation
   void set_mode(const kMode& _mode);
@@ -170,6 +213,9 @@ class Node {
   /// @brief Get index
   /// @returns index_ Index
   uint16_t index() const {return index_;}
+  /// @brief Get data log
+  /// @returns data_log_ Data log
+  DataLogger* data_log() const {return data_log_;}
   /// @brief Get constellation
   /// @returns constellation_ Constellation it belongs to
   uint64_t constellation() const {return constellation_;}
@@ -245,9 +291,10 @@ class Node {
   void UpdateSensingAntenna();
   /// @brief Update measurements
   void UpdateMeasurement();
-  /// @brief Update power management
-  /// @param[in] _charge Whether to charge the battery
-  void UpdatePower(const bool& _charge);
+  /// @brief Starts any planned measurement that is due
+  void StartMeasurement();
+  /// @brief Processes the data of a completed measurement
+  void CompleteMeasurement();
   /// @brief Update commmunication interface
   void UpdateCommunication();
   /// @brief Name
@@ -0,0 +1,201 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef LIBS_COLLABORATE_INCLUDE_COLLABORATE_NODE_LOGGER_H_
+#define LIBS_COLLABORATE_INCLUDE_COLLABORATE_NODE_LOGGER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "collaborate/data_logger.h"
+#include "collaborate/node.h"
+#include "collaborate/trace_logger.h"
+
+namespace osse {
+namespace collaborate {
+
+/// @class NodeLogger
+/// @brief A shared staging buffer that logs every node at once
+/// @details Each parameter is one node-major array holding kLogBufferSize
+/// ticks per node. A full buffer is written as a single [node, time]
+/// hyperslab per parameter (see DataLogger::SimulationMatrix), instead of one
+/// write per node and parameter. A log policy sets how often each parameter
+/// is logged, and whole constellations can be left out. Ticks that are not
+/// logged hold the NetCDF default fill value, and parameters that are not
+/// due are never computed (see Node::ObtainLog).
+class NodeLogger {
+ public:
+  /// @brief Fill value for unlogged double parameters (NetCDF default)
+  static constexpr double kFillDouble = 9.9692099683868690e+36;
+  /// @brief Fill value for unlogged byte parameters (NetCDF default)
+  static constexpr int8_t kFillByte = -127;
+  /// @brief Fill value for unlogged ushort parameters (NetCDF default)
+  static constexpr uint16_t kFillUshort = 65535;
+  /// @brief Fill value for unlogged uint64 parameters (NetCDF default)
+  static constexpr uint64_t kFillUint64 = 18446744073709551614ULL;
+  /// @brief How often a parameter is logged
+  enum class kRate {Every, Change, Off};
+  /// @brief Logging rate of a parameter
+  typedef struct LogRate {
+    /// @brief Every period_ticks ticks, on change, or never
+    kRate rate;
+    /// @brief Ticks between logged values (for kRate::Every)
+    uint64_t period_ticks;
+  } LogRate;
+  /// @brief Logging rates of every parameter
+  typedef struct LogPolicy {
+    /// @brief Index
+    LogRate index;
+    /// @brief Constellation
+    LogRate constellation;
+    /// @brief Operation mode
+    LogRate mode;
+    /// @brief Latitude, longitude, and altitude
+    LogRate position;
+    /// @brief Battery energy stored
+    LogRate energy;
+    /// @brief Charging status
+    LogRate charging;
+    /// @brief Solar panel effective area
+    LogRate area;
+    /// @brief Number of neighbors
+    LogRate num_neighbors;
+  } LogPolicy;
+  /// @brief A node-major buffer for logged node data
+  typedef struct LogBuffer {
+    /// @brief Index
+    std::vector<uint16_t> index;
+    /// @brief Constellation
+    std::vector<uint16_t> constellation;
+    /// @brief Operation mode
+    std::vector<uint64_t> mode;
+    /// @brief Latitude (degrees)
+    std::vector<double> latitude;
+    /// @brief Longitude (degrees)
+    std::vector<double> longitude;
+    /// @brief Altitude (m)
+    std::vector<double> altitude;
+    /// @brief Battery energy stored
+    std::vector<double> energy;
+    /// @brief Charging status
+    std::vector<int8_t> charging;
+    /// @brief Solar panel effective area
+    std::vector<double> area;
+    /// @brief Number of neighbors
+    std::vector<uint16_t> num_neighbors;
+  } LogBuffer;
+  /// @brief Constructor
+  /// @param[in] _data_log Data log (set up with DataLogger::SimulationMatrix)
+  /// @param[in] _num_nodes Number of nodes
+  NodeLogger(DataLogger* _data_log, const uint16_t& _num_nodes);
+  /// @brief Constructor (memory-mapped trace)
+  /// @param[in] _trace_log Trace log (see TraceLogger::SimulationMatrix)
+  /// @param[in] _num_nodes Number of nodes
+  NodeLogger(TraceLogger* _trace_log, const uint16_t& _num_nodes);
+  /// @brief Set log policy
+  /// @param[in] _policy Logging rates of every parameter
+  void set_policy(const LogPolicy& _policy) {policy_ = _policy;}
+  /// @brief Get log policy
+  /// @returns policy_ Logging rates of every parameter
+  const LogPolicy& policy() const {return policy_;}
+  /// @brief Includes or leaves out every node of a constellation
+  /// @param[in] _constellation Constellation
+  /// @param[in] _logged Whether or not the constellation is logged
+  void set_constellation_logged(const uint16_t& _constellation,
+                                const bool& _logged);
+  /// @brief Selects the parameters of a node due in the current tick
+  /// @param[in] _constellation Constellation of the node
+  /// @param[out] _mask Parameters to obtain
+  /// @returns Whether or not any parameter is due
+  bool Due(const uint16_t& _constellation, Node::LogMask* _mask) const;
+  /// @brief Stages one node's parameters for the current tick
+  /// @param[in] _mask Parameters that were obtained
+  /// @param[in] _log Node parameters
+  void Buffer(const Node::LogMask& _mask, const Node::PartialLog& _log);
+  /// @brief Moves to the next tick, writing the buffer when it is full
+  void Advance();
+  /// @brief Writes the staged ticks of every node
+  void Flush();
+
+ private:
+  /// @brief Writes staged ticks of one parameter to the log sink
+  /// @param[in] _variable Variable name
+  /// @param[in] _values Node-major array of values
+  /// @param[in] _count Count of time steps to transfer
+  template <class T>
+  void Log(const std::string& _variable,
+           const T* _values,
+           const uint64_t& _count) {
+    if (trace_log_ != nullptr) {
+      trace_log_->LogMatrix(_variable,
+                            _values,
+                            num_logged_,
+                            num_nodes_,
+                            _count);
+    } else {
+      data_log_->LogMatrix(_variable,
+                           _values,
+                           num_logged_,
+                           num_nodes_,
+                           _count);
+    }
+  }
+  /// @brief Stages a value, unless it is logged on change and unchanged
+  /// @param[in] _rate Logging rate
+  /// @param[in] _value Value
+  /// @param[in,out] _last Last logged value
+  /// @param[out] _slot Staging buffer element
+  template <class T>
+  void Stage(const LogRate& _rate, const T& _value, T* _last, T* _slot) {
+    if ((_rate.rate == kRate::Change) && (*_last == _value)) {
+      return;
+    }
+    *_last = _value;
+    *_slot = _value;
+  }
+  /// @brief Whether or not a parameter is due in the current tick
+  /// @param[in] _rate Logging rate
+  /// @returns Whether or not the parameter is due
+  bool Scheduled(const LogRate& _rate) const;
+  /// @brief Sizes the staging buffer
+  void Allocate();
+  /// @brief Sets every element of a buffer to its fill value
+  /// @param[out] _buffer Buffer
+  void Clear(LogBuffer* _buffer) const;
+  /// @brief Data log (nullptr when logging to a trace)
+  DataLogger* data_log_;
+  /// @brief Trace log (nullptr when logging to a data log)
+  TraceLogger* trace_log_;
+  /// @brief Number of nodes
+  uint16_t num_nodes_;
+  /// @brief Staged node data
+  LogBuffer buffer_;
+  /// @brief Last logged value of each node (for kRate::Change)
+  LogBuffer last_;
+  /// @brief Logging rates of every parameter
+  LogPolicy policy_;
+  /// @brief Whether or not each constellation is logged (default true)
+  std::vector<bool> constellations_;
+  /// @brief Number of staged ticks
+  uint64_t counter_;
+  /// @brief Number of ticks written
+  uint64_t num_logged_;
+};
+
+}  // namespace collaborate
+}  // namespace osse
+
+#endif  // LIBS_COLLABORATE_INCLUDE_COLLABORATE_NODE_LOGGER_H_
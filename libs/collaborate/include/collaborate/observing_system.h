@@ -23,6 +23,7 @@
 #include "collaborate/data_processor.h"
 #include "collaborate/event_logger.h"
 #include "collaborate/node.h"
+#include "collaborate/node_logger.h"
 #include "collaborate/platform_earth.h"
 #include "collaborate/platform_orbit.h"
 #include "collaborate/subsystem_power.h"
@@ -95,11 +96,14 @@ class ObservingSystem {
   /// @brief Get the earth_data of nodes
   /// @returns nodes_ The earth_data of nodes
   std::vector<Node*> nodes() const {return nodes_;}
-  /// @brief Logs the nodes at the end
+  /// @brief Logs the nodes at the end and waits for their logs to be written
   void Complete() const;
   /// @brief Get the scheduler
   /// @returns scheduler_ Scheduler
   Scheduler* scheduler() {return scheduler_;}
+  /// @brief Logs every node through a shared [node, time] staging buffer
+  /// @param[in] _node_log Node logger (nullptr for one group per node)
+  void set_node_log(NodeLogger* _node_log) {node_log_ = _node_log;}
 
 
  protected:
@@ -117,6 +121,8 @@ class ObservingSystem {
   EventLogger* event_log_;
   /// @brief Sun
   Sun* sun_;
+  /// @brief Shared node logger (nullptr when each node logs itself)
+  NodeLogger* node_log_;
 };
 
 }  // namespace collaborate
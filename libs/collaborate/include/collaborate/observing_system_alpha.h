@@ -60,6 +60,21 @@ class ObservingSystemAlpha : public ObservingSystem {
                        EventLogger* _event_log,
                        DataLogger* _network_log,
                        const bool& _flag);
+  /// @brief Constructor (network transition log)
+  /// @param[in] _sun Star at the center of the solar system
+  /// @param[in] _clock Simulation clock
+  /// @param[in] _collaborate Autonomous network collaborate
+  /// @param[in] _event_log Event logger
+  /// @param[in] _network_log Network logger (see DataLogger::UnweightedEvents)
+  /// @param[in] _flag Flag
+  /// @param[in] _snapshot_ticks Ticks between full snapshots (0 for none)
+  ObservingSystemAlpha(Sun* _sun,
+                       SimulationClock* _clock,
+                       Scheduler* _collaborate,
+                       EventLogger* _event_log,
+                       DataLogger* _network_log,
+                       const bool& _flag,
+                       const uint64_t& _snapshot_ticks);
   /// @brief Generates random list of samples to start with
   /// @param[in] _span_s Total time span of the simulation
   void Seed(const uint64_t& _span_s);
@@ -17,6 +17,7 @@
 #define LIBS_COLLABORATE_INCLUDE_COLLABORATE_PACKET_H_
 
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
 namespace osse {
@@ -28,19 +29,35 @@ class Packet {
  public:
   /// @brief Default Constructor
   Packet();
+  /// @brief Reads a generic value from a byte buffer, without copying it
+  /// @details Copies only the value's bytes, so the buffer needs no
+  /// alignment
+  /// @param[in] _data Start of the buffer
+  /// @param[in] _index Index in the buffer
+  /// @returns Unpacked value
+  template <class T>
+  static T Unpack(const uint8_t* _data, const uint64_t& _index) {
+    T unpacked;
+    std::memcpy(&unpacked, _data + _index, sizeof(T));
+    return unpacked;
+  }
   /// @brief Get payload
   /// @returns payload_ Payload
   const std::vector<uint8_t>& payload() const {return payload_;}
+  /// @brief Hands over the payload without copying it
+  /// @details The decoded members stay valid, but payload is left empty
+  /// @returns The payload
+  std::vector<uint8_t> ReleasePayload();
 
  protected:
   /// @brief Default Constructor
-  /// @param[in] _payload The payload
-  explicit Packet(const std::vector<uint8_t>& _payload);
+  /// @param[in] _payload The payload (moved in)
+  explicit Packet(std::vector<uint8_t> _payload);
   /// @brief Inserts a generic value into the payload
   /// @param[in] _value Value
   /// @param[in] _payload Payload
   template <class T>
-  void Pack(const T& _value, std::vector<uint8_t>* _payload) const {
+  static void Pack(const T& _value, std::vector<uint8_t>* _payload) {
     T local = _value;
     uint8_t* start = reinterpret_cast<uint8_t*>(&local);
     _payload->insert(std::end(*_payload), start, start + sizeof(T));
@@ -50,7 +50,7 @@ class PacketForward : public Packet {
   typedef std::array<Event, kMaxTransfers> Route;
   /// @brief Constructor from payload
   /// @param[in] _payload Payload
-  explicit PacketForward(const std::vector<uint8_t>& _payload);
+  explicit PacketForward(std::vector<uint8_t> _payload);
   /// @brief Constructor from data members
   /// @param[in] _partial_route Route
   /// @param[in] _event Measurement event
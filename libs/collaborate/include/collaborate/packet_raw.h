@@ -103,6 +103,41 @@ class PacketRaw : public Packet {
   /// @brief Converts the packet to a string
   /// @returns The packet as a string
   std::string ToString() const;
+  /// @brief Serializes a raw packet onto the end of a data buffer
+  /// @details Writes the same bytes as the payload of a PacketRaw built from
+  /// the same members, without constructing one
+  /// @param[in] _elapsed_s Time elapsed in the simulation (seconds)
+  /// @param[in] _year Year
+  /// @param[in] _month Month
+  /// @param[in] _day Day
+  /// @param[in] _hour Hour
+  /// @param[in] _minute Minute
+  /// @param[in] _second Second
+  /// @param[in] _microsecond Microsecond
+  /// @param[in] _latitude_rad Latitude (radians)
+  /// @param[in] _longitude_rad Longitude (radians)
+  /// @param[in] _altitude_m Altitude (meters)
+  /// @param[in] _measurement Measurement
+  /// @param[in] _resolution_radius_m Resolution (meters)
+  /// @param[in] _name Variable name of data set (kMaxStringSize characters)
+  /// @param[in] _informer_index Informer index index
+  /// @param[out] _buffer Data buffer
+  static void Append(const uint64_t& _elapsed_s,
+                     const int& _year,
+                     const int& _month,
+                     const int& _day,
+                     const int& _hour,
+                     const int& _minute,
+                     const int& _second,
+                     const int& _microsecond,
+                     const double& _latitude_rad,
+                     const double& _longitude_rad,
+                     const double& _altitude_m,
+                     const double& _measurement,
+                     const double& _resolution_radius_m,
+                     const std::string& _name,
+                     const uint16_t& _informer_index,
+                     std::vector<uint8_t>* _buffer);
   /// @brief Get Year
   /// @returns year_ Year
   const uint64_t& elapsed_s() const {return elapsed_s_;}
@@ -185,8 +220,8 @@ class PacketRaw : public Packet {
   /// @brief Inserts a string into the payload
   /// @param[in] _string String
   /// @param[in] _payload Payload
-  void PackString(const std::string& _string,
-                  std::vector<uint8_t>* _payload) const;
+  static void PackString(const std::string& _string,
+                         std::vector<uint8_t>* _payload);
   /// @brief Unpacks a string from the payload
   /// @param[in] _payload Payload
   /// @param[in] _index Index
@@ -233,12 +268,100 @@ inline std::ostream& operator<<(std::ostream& strm,
   return strm << _raw_packet.ToString();
 }
 
+/// @class PacketRawView
+/// @brief A read-only view of a raw packet in a data buffer
+/// @details Fields are read from the buffer on access, so a view allocates
+/// nothing (except name) and must not outlive the buffer
+class PacketRawView {
+ public:
+  /// @brief Constructor
+  /// @param[in] _data Start of the packet (PacketRaw::kPacketRawSizeBytes)
+  explicit PacketRawView(const uint8_t* _data);
+  /// @brief Get time elapsed in the simulation (seconds)
+  /// @returns Time elapsed in the simulation (seconds)
+  uint64_t elapsed_s() const {
+    return Packet::Unpack<uint64_t>(data_, PacketRaw::kElapsedSIndex);
+  }
+  /// @brief Get Year
+  /// @returns Year
+  int year() const {return Packet::Unpack<int>(data_, PacketRaw::kYearIndex);}
+  /// @brief Get Month
+  /// @returns Month
+  int month() const {
+    return Packet::Unpack<int>(data_, PacketRaw::kMonthIndex);
+  }
+  /// @brief Get Day
+  /// @returns Day
+  int day() const {return Packet::Unpack<int>(data_, PacketRaw::kDayIndex);}
+  /// @brief Get Hour
+  /// @returns Hour
+  int hour() const {return Packet::Unpack<int>(data_, PacketRaw::kHourIndex);}
+  /// @brief Get Minute
+  /// @returns Minute
+  int minute() const {
+    return Packet::Unpack<int>(data_, PacketRaw::kMinuteIndex);
+  }
+  /// @brief Get Second
+  /// @returns Second
+  int second() const {
+    return Packet::Unpack<int>(data_, PacketRaw::kSecondIndex);
+  }
+  /// @brief Get Microsecond
+  /// @returns Microsecond
+  int microsecond() const {
+    return Packet::Unpack<int>(data_, PacketRaw::kMicrosecondIndex);
+  }
+  /// @brief Get Latitude (radians)
+  /// @returns Latitude (radians)
+  double latitude_rad() const {
+    return Packet::Unpack<double>(data_, PacketRaw::kLatitudeRadIndex);
+  }
+  /// @brief Get Longitude (radians)
+  /// @returns Longitude (radians)
+  double longitude_rad() const {
+    return Packet::Unpack<double>(data_, PacketRaw::kLongitudeRadIndex);
+  }
+  /// @brief Get Altitude (meters)
+  /// @returns Altitude (meters)
+  double altitude_m() const {
+    return Packet::Unpack<double>(data_, PacketRaw::kAltitudeMIndex);
+  }
+  /// @brief Get Measurement
+  /// @returns Measurement
+  double measurement() const {
+    return Packet::Unpack<double>(data_, PacketRaw::kMeasurementIndex);
+  }
+  /// @brief Get Resolution radius (meters)
+  /// @returns Resolution radius (meters)
+  double resolution_radius_m() const {
+    return Packet::Unpack<double>(data_, PacketRaw::kResolutionRadMIndex);
+  }
+  /// @brief Get Variable name of the data-set
+  /// @returns Variable name of the data-set
+  std::string name() const;
+  /// @brief Get informer index
+  /// @returns Informer index
+  uint16_t informer_index() const {
+    return Packet::Unpack<uint16_t>(data_, PacketRaw::kInformerIndexIndex);
+  }
+
+ private:
+  /// @brief Start of the packet
+  const uint8_t* data_;
+};
+
 /// @fn std::vector<PacketRaw> ReadRawBuffer(std::vector<uint8_t> _buffer)
 /// @brief Obtains a list of raw packets from the data buffer
 /// @param[in] _data_buffer Data buffer
 /// @returns Raw packets
 std::vector<PacketRaw> ReadRawBuffer(const std::vector<uint8_t>& _buffer);
 
+/// @fn std::vector<PacketRawView> ViewRawBuffer(std::vector<uint8_t> _buffer)
+/// @brief Obtains views of the raw packets in the data buffer
+/// @param[in] _buffer Data buffer (must outlive the views)
+/// @returns Raw packet views
+std::vector<PacketRawView> ViewRawBuffer(const std::vector<uint8_t>& _buffer);
+
 }  // namespace collaborate
 }  // namespace osse
 
@@ -47,7 +47,7 @@ class PacketReturn : public Packet {
   typedef std::array<Event, kMaxTransfers> Route;
   /// @brief Constructor from payload
   /// @param[in] _payload Payload
-  explicit PacketReturn(const std::vector<uint8_t>& _payload);
+  explicit PacketReturn(std::vector<uint8_t> _payload);
   /// @brief Constructor from data members
   /// @param[in] _partial_route Route
   /// @param[in] _success Whether the threshold was exceeded
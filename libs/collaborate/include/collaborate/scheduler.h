@@ -27,6 +27,7 @@
 #include "collaborate/node.h"
 #include "collaborate/simulation_clock.h"
 #include "collaborate/tree.h"
+#include "collaborate/tree_logger.h"
 
 namespace osse {
 namespace collaborate {
@@ -70,11 +71,14 @@ class Scheduler {
   /// @brief Fills the weighted graph with distances
   /// @param[in] _weighted Weighted graph
   void AllDist(GraphWeighted* _weighted);
+  /// @brief Set the routing tree log (trees are not exported without one)
+  /// @param[in] _tree_log Routing tree log
+  void set_tree_log(TreeLogger* _tree_log) {tree_log_ = _tree_log;}
 
  protected:
   /// @brief Restores all nodes to original orbital_state
   void RestoreNodes();
-  /// @brief Saves a tree to a text file
+  /// @brief Queues a tree for export to the tree log (if one is set)
   /// @param[in] _tree Tree
   /// @param[in] _start Start node index
   /// @param[in] _end End node index
@@ -85,6 +89,8 @@ class Scheduler {
   SimulationClock* clock_;
   /// @brief Current nodes from sensor network
   std::vector<Node*> nodes_;
+  /// @brief Routing tree log
+  TreeLogger* tree_log_;
 };
 
 }  // namespace collaborate
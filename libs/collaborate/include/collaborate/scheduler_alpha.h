@@ -113,13 +113,6 @@ class SchedulerAlpha : public Scheduler {
                    const uint64_t& _duration_s,
                    const uint64_t& _original_s,
                    const uint64_t& _lower_limit_s);
-  /// @brief Obtain the string log for the route
-  /// @param[in] _start_index Starting node index
-  /// @param[in] _route List of individual transfers
-  /// @returns String log for the route
-  std::string GetRouteLog(
-      const uint16_t& _start_index,
-      const std::vector<std::pair<uint16_t, uint64_t>>& _route);
   /// @brief Flag
   bool flag_;
 };
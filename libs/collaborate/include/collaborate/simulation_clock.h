@@ -23,6 +23,7 @@
 #include "sgp4/date_time.h"
 
 #include "collaborate/data_logger.h"
+#include "collaborate/trace_logger.h"
 
 namespace osse {
 namespace collaborate {
@@ -31,12 +32,20 @@ namespace collaborate {
 /// @brief A clock for maintaining the current simulation time
 class SimulationClock {
  public:
-  /// @brief Size of a log buffer
+  /// @brief Size of a log buffer (in runs)
   static constexpr int kLogBufferSize = 1000;
   /// @brief Log buffer
+  /// @details The clock is logged as runs of ticks with a constant step:
+  /// each run holds its first tick, its step, and the date and time at its
+  /// first tick. The date and time at tick t of a run starting at tick t0
+  /// is the run's date and time plus (t - t0) * step (seconds).
   typedef struct LogBuffer {
     /// @brief Counter
     int counter;
+    /// @brief First tick
+    uint64_t tick[kLogBufferSize];
+    /// @brief Step (seconds)
+    uint64_t step_s[kLogBufferSize];
     /// @brief Year
     int year[kLogBufferSize];
     /// @brief Month
@@ -97,8 +106,12 @@ class SimulationClock {
   /// @brief Get total ticks
   /// @returns ticks_ Total ticks
   const uint64_t& ticks() const {return ticks_;}
-  /// @brief Buffer clock values
-  void Buffer();
+  /// @brief Set trace log (replaces the data logger as the clock log sink)
+  /// @param[in] _trace_log Trace log (set up with a simulation layout)
+  void set_trace_log(TraceLogger* _trace_log) {trace_log_ = _trace_log;}
+  /// @brief Buffer clock values (starts a new run if the step changes)
+  /// @param[in] _step_s Step from this tick to the next (seconds)
+  void Buffer(const uint64_t& _step_s);
   /// @brief Write buffers to a log file
   void Flush();
 
@@ -113,6 +126,12 @@ class SimulationClock {
   uint64_t ticks_;
   /// @brief Data logger
   DataLogger* data_log_;
+  /// @brief Trace logger (nullptr to log to the data logger)
+  TraceLogger* trace_log_;
+  /// @brief Number of runs buffered or written
+  uint64_t num_runs_;
+  /// @brief Step of the current run (seconds)
+  uint64_t run_step_s_;
   /// @brief Log buffer
   LogBuffer log_buffer_;
 };
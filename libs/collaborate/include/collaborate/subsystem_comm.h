@@ -87,9 +87,12 @@ class SubsystemComm {
   void LoadData(const std::vector<uint8_t>& _payload);
   /// @brief Empties data buffer
   void EraseDataBuffer();
+  /// @brief Hands over the data buffer without copying it
+  /// @returns The data buffer (leaving it empty)
+  std::vector<uint8_t> ReleaseDataBuffer();
   /// @brief Set data buffer
-  /// @param[in] _data_buffer Data buffer
-  void set_data_buffer(const std::vector<uint8_t>& _data_buffer);
+  /// @param[in] _data_buffer Data buffer (moved in)
+  void set_data_buffer(std::vector<uint8_t> _data_buffer);
   /// @brief Get Antenna
   /// @returns kAntenna_ Antenna
   const Antenna* kAntenna() const {return kAntenna_;}
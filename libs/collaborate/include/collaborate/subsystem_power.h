@@ -42,7 +42,7 @@ class SubsystemPower {
   SubsystemPower(const Battery& _battery,
                  const std::vector<SolarPanel> _solar_panels,
                  const double& _idle_power_w);
-  /// @brief Updates the system's net energy stored
+  /// @brief Updates the system's net energy stored and panel orientations
   /// @param[in] _charge Whether to charge the battery
   /// @param[in] _simulation_clock Simulation simulation_clock
   /// @param[in] _body_frame Host body reference_frame
@@ -59,7 +59,7 @@ class SubsystemPower {
   /// @returns battery_ Battery
   const Battery& battery() const {return battery_;}
   /// @brief Get Panels
-  /// @returns solar_panels_ Panels
+  /// @returns solar_panels_ Panels (effective areas as of the last update)
   const std::vector<SolarPanel>& solar_panels() const {return solar_panels_;}
   /// @brief Get whether the system is charging
   /// @returns charging_ Whether the system is charging
@@ -17,13 +17,17 @@
 #define LIBS_COLLABORATE_INCLUDE_COLLABORATE_SUBSYSTEM_SENSING_H_
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include "collaborate/antenna.h"
 #include "collaborate/data_logger.h"
+#include "collaborate/geodetic.h"
+#include "collaborate/measurement_logger.h"
 #include "collaborate/reference_frame.h"
 #include "collaborate/sensor.h"
 #include "collaborate/simulation_clock.h"
+#include "collaborate/util.h"
 #include "collaborate/vector.h"
 
 namespace osse {
@@ -33,41 +37,23 @@ namespace collaborate {
 /// @brief An interface for RF sensing
 class SubsystemSensing {
  public:
-  /// @brief A buffer for logged node data
-  typedef struct LogBuffer {
-    /// @brief Elapsed time (seconds)
-    std::vector<uint64_t> elapsed_s;
-    /// @brief Year
-    std::vector<int> year;
-    /// @brief Month
-    std::vector<int> month;
-    /// @brief Day
-    std::vector<int> day;
-    /// @brief Hour
-    std::vector<int> hour;
-    /// @brief Minute
-    std::vector<int> minute;
-    /// @brief Second
-    std::vector<int> second;
-    /// @brief Microsecond
-    std::vector<int> microsecond;
-    /// @brief Latitude (radians)
-    std::vector<double> latitude_rad;
-    /// @brief Longitude (radians)
-    std::vector<double> longitude_rad;
-    /// @brief Altitude (meters)
-    std::vector<double> altitude_m;
-    /// @brief Meaurement
-    std::vector<double> measurement;
-    /// @brief Measurement resolution (m)
-    std::vector<double> resolution_m;
-    /// @brief Node index
-    std::vector<uint16_t> index;
-  } LogBuffer;
+  /// @brief A buffer for logged measurement data
+  typedef MeasurementLogger::LogBuffer LogBuffer;
+  /// @brief Widest half beamwidth integrated (wider beams are clamped)
+  static constexpr double kMaxHalfBeamwidthRad = util::kPiRad / 4;
+  /// @brief Smallest cosine of the incidence angle (grazing views clamp)
+  static constexpr double kMinCosIncidence = 0.1;
   /// @brief Constructor
   /// @param[in] _antenna The antenna
   /// @param[in] _sensor The sensor
   SubsystemSensing(const Antenna* _antenna, Sensor* _sensor);
+  /// @brief Constructor with a consolidated measurement log
+  /// @param[in] _antenna The antenna
+  /// @param[in] _sensor The sensor
+  /// @param[in] _measurement_log Measurement log shared by the sensor variable
+  SubsystemSensing(const Antenna* _antenna,
+                   Sensor* _sensor,
+                   MeasurementLogger* _measurement_log);
   /// @brief Measures for a specified time
   /// @param[in] _informer_index Index of the informer node
   void Measure(const uint16_t& _informer_index);
@@ -77,6 +63,29 @@ class SubsystemSensing {
   /// @param[in] _node_index Unknown
   /// @returns active_
   bool Update(const SimulationClock& _clock, const Vector& _position_m_rad, const int _node_index);
+  /// @brief Obtains a measurement for every active interface of a swath
+  /// @details Intersects every boresight with the Earth first, then samples
+  /// each earth_data once for all of the ground points that share it
+  /// @param[in] _clock The simulation clock
+  /// @param[in] _sensing Sensing interfaces
+  /// @param[in] _positions_m_rad Positions of the nodes
+  /// @param[in] _node_indices Indices of the nodes
+  static void UpdateSwath(const SimulationClock& _clock,
+                          const std::vector<SubsystemSensing*>& _sensing,
+                          const std::vector<Vector>& _positions_m_rad,
+                          const std::vector<int>& _node_indices);
+  /// @brief Obtains the footprint of the beam on Earth's surface
+  /// @details The circle with the area of the half-power beam's ellipse on
+  /// a plane tangent to the ground point, which is stretched by 1 / cos of
+  /// the incidence angle along the look direction. An antenna with no
+  /// half-power crossing (see Antenna::BeamwidthRad) covers one grid cell.
+  /// @param[in] _clock The simulation clock
+  /// @param[in] _position_m_rad The position of the node
+  /// @param[in] _place Intersection of the boresight with Earth's surface
+  /// @returns Footprint radius (meters)
+  double FootprintRadiusM(const SimulationClock& _clock,
+                          const Vector& _position_m_rad,
+                          const Geodetic& _place) const;
   /// @brief Calculates a new attitude frame for the antenna
   /// @param _orbit_frame Satellite orbit frame
   /// @param _body_frame Satellite body frame
@@ -87,9 +96,19 @@ class SubsystemSensing {
   void LoadData(const std::vector<uint8_t>& _payload);
   /// @brief Empties data buffer
   void EraseDataBuffer();
+  /// @brief Hands over the data buffer without copying it
+  /// @returns The data buffer (leaving it empty)
+  std::vector<uint8_t> ReleaseDataBuffer();
   /// @brief Set data buffer
-  /// @param[in] _data_buffer Data buffer
-  void set_data_buffer(const std::vector<uint8_t>& _data_buffer);
+  /// @param[in] _data_buffer Data buffer (moved in)
+  void set_data_buffer(std::vector<uint8_t> _data_buffer);
+  /// @brief Set whether or not measurements integrate over the footprint
+  /// @details Otherwise the grid is sampled at the boresight (and the
+  /// resolution logged is 0). Enabling it logs the footprint radius as the
+  /// resolution, and has frames of the sensor's variable build their
+  /// summed-area tables on load.
+  /// @param[in] _footprint Whether or not to integrate over the footprint
+  void set_footprint(const bool& _footprint);
   /// @brief Get Antenna
   /// @returns kAntenna_ Antenna
   const Antenna* kAntenna() const {return kAntenna_;}
@@ -119,10 +138,38 @@ class SubsystemSensing {
   const bool& complete() const {return complete_;}
 
  private:
-  /// @brief Output the logged data to a netcdf file
+  /// @brief Output the logged data to the measurement log (or a netcdf file)
   /// @param[in] _clock The simulation clock
   /// @param[in] _node_index Unknown
   void Flush(const SimulationClock& _clock, const int _node_index);
+  /// @brief Updates the sensor and finds the boresight ground point
+  /// @param[in] _clock The simulation clock
+  /// @param[in] _position_m_rad The position of the node
+  /// @param[out] _place Intersection of the boresight with Earth's surface
+  /// @param[out] _radius_m Footprint radius (meters, 0 unless integrating)
+  /// @returns active_
+  bool Aim(const SimulationClock& _clock,
+           const Vector& _position_m_rad,
+           Geodetic* _place,
+           double* _radius_m);
+  /// @brief Appends a sample to the data buffer and the logged data
+  /// @param[in] _clock The simulation clock
+  /// @param[in] _place Location of the sample
+  /// @param[in] _measurement The sample
+  /// @param[in] _radius_m Footprint radius (meters, 0 if not integrating)
+  /// @param[in] _node_index Unknown
+  void Record(const SimulationClock& _clock,
+              const Geodetic& _place,
+              const double& _measurement,
+              const double& _radius_m,
+              const int _node_index);
+  /// @brief Reserves room for the samples of a measurement
+  /// @param[in] _num_samples Number of samples
+  void Reserve(const uint64_t& _num_samples);
+  /// @brief Pads a variable name to the packed string size
+  /// @param[in] _variable Variable name
+  /// @returns Variable name, right-aligned in PacketRaw::kMaxStringSize
+  static std::string Pad(const std::string& _variable);
   /// @brief The sensor
   Sensor* sensor_;
   /// @brief The time limit for activity
@@ -131,8 +178,12 @@ class SubsystemSensing {
   bool complete_;
   /// @brief Index of the informer node
   uint16_t informer_index_;
+  /// @brief Padded variable name packed into every raw packet
+  std::string name_;
   /// @brief Buffer for logged data
   LogBuffer buffer_;
+  /// @brief Consolidated measurement log (one file per measurement if null)
+  MeasurementLogger* measurement_log_;
   /// @brief Antenna
   const Antenna* kAntenna_;
   /// @brief Antenna reference frame
@@ -143,6 +194,10 @@ class SubsystemSensing {
   bool active_;
   /// @brief Get time counter (seconds)
   uint64_t elapsed_s_;
+  /// @brief Half of the antenna's half-power beamwidth (radians)
+  double half_beamwidth_rad_;
+  /// @brief Whether or not measurements integrate over the footprint
+  bool footprint_;
 };
 
 }  // namespace collaborate
@@ -0,0 +1,190 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef LIBS_COLLABORATE_INCLUDE_COLLABORATE_TRACE_LOGGER_H_
+#define LIBS_COLLABORATE_INCLUDE_COLLABORATE_TRACE_LOGGER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "collaborate/data_logger.h"
+
+namespace osse {
+namespace collaborate {
+
+/// @class TraceLogger
+/// @brief A memory-mapped, columnar binary alternative to DataLogger
+/// @details The file is sized and mapped once the layout is set up, so a
+/// logged buffer is a memcpy into mapped pages with no library calls. A
+/// header lists each column's name, NetCDF type name, number of rows, byte
+/// offset, and number of ticks written. Each column holds rows x ticks
+/// values, row-major and page-aligned. Convert rewrites a trace as the
+/// NetCDF file the DataLogger would have produced.
+class TraceLogger {
+ public:
+  /// @brief File identifier
+  static constexpr char kMagic[8] = "OSSETRC";
+  /// @brief File format version
+  static constexpr uint32_t kVersion = 2;
+  /// @brief Column alignment (bytes)
+  static constexpr uint64_t kAlignment = 4096;
+  /// @brief Maximum column name length (including the terminator)
+  static constexpr uint64_t kNameLength = 24;
+  /// @brief Maximum type name length (including the terminator)
+  static constexpr uint64_t kTypeLength = 8;
+  /// @brief File header
+  typedef struct Header {
+    /// @brief File identifier
+    char magic[8];
+    /// @brief File format version
+    uint32_t version;
+    /// @brief Number of columns
+    uint32_t num_columns;
+    /// @brief Number of nodes
+    uint64_t num_nodes;
+    /// @brief Number of simulation ticks
+    uint64_t ticks;
+    /// @brief Reserved
+    uint64_t reserved[4];
+  } Header;
+  /// @brief Column header
+  typedef struct Column {
+    /// @brief Variable name
+    char name[kNameLength];
+    /// @brief NetCDF type name
+    char type[kTypeLength];
+    /// @brief Number of rows (1 for a time series, or the number of nodes)
+    uint64_t rows;
+    /// @brief Size of one value (bytes)
+    uint64_t size;
+    /// @brief Byte offset of the first value
+    uint64_t offset;
+    /// @brief Number of ticks written (highest written index plus one)
+    uint64_t length;
+  } Column;
+  /// @brief Constructor
+  /// @param[in] _path File sink path
+  explicit TraceLogger(const std::string& _path);
+  /// @brief Destructor (unmaps and closes the file)
+  ~TraceLogger();
+  /// @brief Sets up and maps the file for logging node data as [node, time]
+  /// @details Holds the same variables as DataLogger::SimulationMatrix
+  /// @param[in] _num_nodes Number of nodes
+  /// @param[in] _ticks Number of simulation ticks
+  void SimulationMatrix(const uint16_t& _num_nodes, const uint64_t& _ticks);
+  /// @brief Logs a node-major buffer of [node, time] data
+  /// @param[in] _variable Column name
+  /// @param[in] _values Array of values (count values for each node)
+  /// @param[in] _index Time index in the column
+  /// @param[in] _num_nodes Number of nodes
+  /// @param[in] _count Count of time steps to transfer
+  template <class T>
+  void LogMatrix(const std::string& _variable,
+                 const T* _values,
+                 const uint64_t& _index,
+                 const uint16_t& _num_nodes,
+                 const uint64_t& _count) {
+    Column* column = Find(_variable, sizeof(T), _index, _count);
+    if (column == nullptr) {
+      return;
+    }
+    uint16_t rows = std::min<uint64_t>(_num_nodes, column->rows);
+    for (uint16_t n = 0; n < rows; ++n) {
+      std::memcpy(data_ + column->offset + (n * ticks_ + _index) * sizeof(T),
+                  _values + n * _count,
+                  _count * sizeof(T));
+    }
+  }
+  /// @brief Logs a buffer of time series data at an offset
+  /// @param[in] _variable Column name
+  /// @param[in] _values Array of values
+  /// @param[in] _index Time index in the column
+  /// @param[in] _count Count of elements to transfer
+  template <class T>
+  void LogSeries(const std::string& _variable,
+                 const T* _values,
+                 const uint64_t& _index,
+                 const uint64_t& _count) {
+    LogMatrix(_variable, _values, _index, 1, _count);
+  }
+  /// @brief Rewrites a trace as a NetCDF file with the same layout
+  /// @param[in] _trace_path Trace file path
+  /// @param[in] _netcdf_path NetCDF file sink path
+  /// @returns Whether or not the trace could be read
+  static bool Convert(const std::string& _trace_path,
+                      const std::string& _netcdf_path);
+
+ private:
+  /// @brief Adds a column to the layout
+  /// @param[in] _name Column name
+  /// @param[in] _type NetCDF type name
+  /// @param[in] _size Size of one value (bytes)
+  /// @param[in] _rows Number of rows
+  void AddColumn(const std::string& _name,
+                 const std::string& _type,
+                 const uint64_t& _size,
+                 const uint64_t& _rows);
+  /// @brief Sizes and maps the file, then writes the header
+  void Map();
+  /// @brief Looks up a column for a write, and records its length
+  /// @details Reports the first dropped write of each column to std::cerr
+  /// @param[in] _variable Column name
+  /// @param[in] _size Size of one value (bytes)
+  /// @param[in] _index Time index of the write
+  /// @param[in] _count Count of time steps in the write
+  /// @returns Column (nullptr if missing, mistyped, or out of range)
+  Column* Find(const std::string& _variable,
+               const uint64_t& _size,
+               const uint64_t& _index,
+               const uint64_t& _count);
+  /// @brief Copies a column into a NetCDF variable
+  /// @param[in] _data_log NetCDF sink
+  /// @param[in] _column Column
+  /// @param[in] _data Mapped trace file
+  /// @param[in] _ticks Number of simulation ticks
+  template <class T>
+  static void ConvertColumn(DataLogger* _data_log,
+                            const Column& _column,
+                            const char* _data,
+                            const uint64_t& _ticks);
+  /// @brief File sink path
+  std::string path_;
+  /// @brief File descriptor
+  int file_;
+  /// @brief Mapped file (nullptr until mapped)
+  char* data_;
+  /// @brief Size of the mapped file (bytes)
+  uint64_t size_;
+  /// @brief Number of nodes
+  uint64_t num_nodes_;
+  /// @brief Number of simulation ticks
+  uint64_t ticks_;
+  /// @brief Column layout (copied into the header when mapped)
+  std::vector<Column> layout_;
+  /// @brief Mapped column headers, by name
+  std::map<std::string, Column*> columns_;
+  /// @brief Columns with a dropped write (reported once each)
+  std::set<std::string> dropped_;
+};
+
+}  // namespace collaborate
+}  // namespace osse
+
+#endif  // LIBS_COLLABORATE_INCLUDE_COLLABORATE_TRACE_LOGGER_H_
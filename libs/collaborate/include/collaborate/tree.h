@@ -17,6 +17,7 @@
 #define LIBS_COLLABORATE_INCLUDE_COLLABORATE_TREE_H_
 
 #include <cstdint>
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -44,6 +45,17 @@ class Tree {
     /// @brief Message received time (seconds)
     uint64_t rx_time_s;
   } Branch;
+  /// @brief A branch as exported, in depth-first order
+  typedef struct Entry {
+    /// @brief Level of the branch in the tree
+    uint16_t level;
+    /// @brief Index of the corresponding satellite node
+    uint16_t index;
+    /// @brief Message received time (seconds)
+    uint64_t rx_time_s;
+    /// @brief Whether or not the branch is a leaf
+    bool leaf;
+  } Entry;
   /// @brief Constructor
   /// @param[in] _root Root node
   /// @param[in] _height Maximum levels in the tree
@@ -91,6 +103,28 @@ class Tree {
   /// @brief Write the tree to a LaTeX Tikz file
   /// @param[in] _path Path to the log file
   void Log(const std::string& _path) const;
+  /// @brief Copies the branches in depth-first order (for exporting later)
+  /// @returns Branches, starting with the root
+  std::vector<Entry> Flatten() const;
+  /// @brief Writes flattened branches to a standalone LaTeX Tikz file
+  /// @param[in] _entries Branches (see Flatten)
+  /// @param[in] _path Path to the log file
+  static void WriteDocument(const std::vector<Entry>& _entries,
+                            const std::string& _path);
+  /// @brief Writes flattened branches as a LaTeX forest environment
+  /// @param[in] _entries Branches (see Flatten)
+  /// @param[out] _stream Output stream
+  static void WriteForest(const std::vector<Entry>& _entries,
+                          std::ostream* _stream);
+  /// @brief Writes flattened branches as an edge list
+  /// @details One line per branch: the prefix, then level, parent node,
+  /// node, and received time (seconds). The root is its own parent.
+  /// @param[in] _entries Branches (see Flatten)
+  /// @param[in] _prefix Text that starts every line
+  /// @param[out] _stream Output stream
+  static void WriteEdges(const std::vector<Entry>& _entries,
+                         const std::string& _prefix,
+                         std::ostream* _stream);
   /// @brief Set the root tree node
   /// @param _root Root tree node
   void set_root(Branch* _root) {root_ = _root;}
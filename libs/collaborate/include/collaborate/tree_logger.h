@@ -0,0 +1,114 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef LIBS_COLLABORATE_INCLUDE_COLLABORATE_TREE_LOGGER_H_
+#define LIBS_COLLABORATE_INCLUDE_COLLABORATE_TREE_LOGGER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "collaborate/tree.h"
+
+namespace osse {
+namespace collaborate {
+
+/// @class TreeLogger
+/// @brief Exports routing trees on a background thread
+/// @details The caller only copies the tree (see Tree::Flatten) into a
+/// bounded queue, and a dedicated thread formats and writes it. Trees can
+/// be sampled, and go either to one LaTeX file each or to a single file.
+class TreeLogger {
+ public:
+  /// @brief Maximum number of queued trees
+  static constexpr uint64_t kQueueDepth = 256;
+  /// @brief Export formats
+  enum class kFormat {
+    /// One standalone LaTeX file per tree (the path is a prefix)
+    TikzFiles,
+    /// Forest environments appended to one file
+    Tikz,
+    /// Edge lists appended to one file (see Tree::WriteEdges)
+    EdgeList
+  };
+  /// @brief Constructor
+  /// @param[in] _path File sink path (or prefix, for kFormat::TikzFiles)
+  /// @param[in] _format Export format
+  /// @param[in] _every Export one of every this many trees
+  TreeLogger(const std::string& _path,
+             const kFormat& _format,
+             const uint64_t& _every);
+  /// @brief Destructor (writes queued trees and closes the file)
+  ~TreeLogger();
+  /// @brief Queues a tree for export (if it is sampled)
+  /// @param[in] _start Start node index
+  /// @param[in] _end End node index
+  /// @param[in] _elapsed_s Elapsed simulation time (seconds)
+  /// @param[in] _tree Tree
+  void Save(const uint16_t& _start,
+            const uint16_t& _end,
+            const uint64_t& _elapsed_s,
+            const Tree& _tree);
+
+ private:
+  /// @brief A queued tree
+  typedef struct Request {
+    /// @brief Start node index
+    uint16_t start;
+    /// @brief End node index
+    uint16_t end;
+    /// @brief Elapsed simulation time (seconds)
+    uint64_t elapsed_s;
+    /// @brief Branches in depth-first order
+    std::vector<Tree::Entry> entries;
+  } Request;
+  /// @brief Writes one tree
+  /// @param[in] _request Queued tree
+  void Write(const Request& _request);
+  /// @brief Writes queued trees until the logger is destroyed
+  void Drain();
+  /// @brief File sink path (or prefix)
+  std::string path_;
+  /// @brief Export format
+  kFormat format_;
+  /// @brief Export one of every this many trees
+  uint64_t every_;
+  /// @brief Number of trees offered for export
+  uint64_t num_trees_;
+  /// @brief Single-file sink
+  std::ofstream file_;
+  /// @brief Queued trees
+  std::deque<Request> queue_;
+  /// @brief Guards the queue
+  std::mutex queue_mutex_;
+  /// @brief Signals a new tree or shutdown to the writer
+  std::condition_variable queue_ready_;
+  /// @brief Signals free space in the queue
+  std::condition_variable queue_space_;
+  /// @brief Whether or not the writer should exit once the queue is empty
+  bool stopping_;
+  /// @brief Writer thread
+  std::thread writer_;
+};
+
+}  // namespace collaborate
+}  // namespace osse
+
+#endif  // LIBS_COLLABORATE_INCLUDE_COLLABORATE_TREE_LOGGER_H_
@@ -21,6 +21,7 @@
 #include <cmath>
 #include <complex>
 #include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <random>
 #include <sstream>
@@ -102,6 +103,35 @@ inline uint64_t Index(const uint64_t& _row,
   return (_row * _num_columns + _column);
 }
 
+/// @fn float FloatFromHalf(const uint16_t& _half)
+/// @brief Widens an IEEE 754 half-precision number
+/// @param[in] _half Half-precision bits
+/// @returns Single-precision number
+inline float FloatFromHalf(const uint16_t& _half) {
+  uint32_t sign = static_cast<uint32_t>(_half & 0x8000) << 16;
+  uint32_t exponent = (_half >> 10) & 0x1f;
+  uint32_t mantissa = _half & 0x3ff;
+  if (exponent == 0) {
+    // Zero or subnormal
+    float value = std::ldexp(static_cast<float>(mantissa), -24);
+    return (sign != 0) ? -value : value;
+  }
+  uint32_t bits = sign | (mantissa << 13);
+  if (exponent == 0x1f) {
+    bits |= 0x7f800000;
+  } else {
+    bits |= (exponent + 112) << 23;
+  }
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/// @brief Narrows a number to IEEE 754 half precision (to nearest, even)
+/// @param[in] _value Single-precision number
+/// @returns Half-precision bits
+uint16_t HalfFromFloat(const float& _value);
+
 /// @brief Finds minimum positive root of a truncated polynomial (4th degree)
 /// @param[in] _coefficients Coefficients of polynomial
 /// @returns Minimum positive root of a truncated polynomial (4th degree)
@@ -15,6 +15,7 @@
 
 #include "collaborate/antenna.h"
 
+#include <cstdint>
 #include <string>
 
 #include "collaborate/data_logger.h"
@@ -23,6 +24,9 @@
 namespace osse {
 namespace collaborate {
 
+constexpr double Antenna::kHalfPowerDb;
+constexpr double Antenna::kNoBeamwidthRad;
+
 Antenna::Antenna(const double& _max_gain_db,
                  const double& _roll_rad,
                  const double& _pitch_rad,
@@ -33,6 +37,18 @@ Antenna::Antenna(const double& _max_gain_db,
       kYawRad_(_yaw_rad) {
 }
 
+double Antenna::BeamwidthRad() const {
+  constexpr uint64_t kThetaTicks = 10000;
+  double edge_db = GainDb(0, 0) - kHalfPowerDb;
+  for (uint64_t t = 1; t <= kThetaTicks; ++t) {
+    double theta_rad = util::kPiRad * t / kThetaTicks;
+    if (GainDb(theta_rad, 0) <= edge_db) {
+      return 2 * theta_rad;
+    }
+  }
+  return kNoBeamwidthRad;
+}
+
 void Antenna::Log(const std::string& _path) const {
   constexpr uint64_t kThetaTicks = 100;
   constexpr uint64_t kPhiTicks = 100;
@@ -123,7 +123,7 @@ void Channel::FakeTransfer(const SimulationClock& _clock) {
 }
 
 void Channel::RealTransfer() {
-  rx_node_->SetCommBuffer(tx_node_->comm_if().data_buffer());
+  rx_node_->SetCommBuffer(tx_node_->ReleaseCommBuffer());
   tx_node_->set_mode(Node::kMode::Free);
   rx_node_->set_mode(Node::kMode::Free);
   tx_node_->SwitchCommunication(SubsystemComm::kMode::Free);
@@ -15,128 +15,379 @@
 
 #include "collaborate/data_logger.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <exception>
 #include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "netcdf/ncDim.h"
+#include "netcdf/ncException.h"
+
+#include "collaborate/node.h"
 
 namespace osse {
 namespace collaborate {
 
+std::mutex DataLogger::netcdf_mutex_;
+
 DataLogger::DataLogger(const std::string& _path)
-    : ncfile_(_path, netCDF::NcFile::FileMode::replace),
-      groups_({}) {
+    : ncfile_(),
+      groups_({}),
+      storage_({Node::kLogBufferSize, 1, true, false}),
+      queue_depth_(0),
+      writing_(false),
+      stopping_(false),
+      error_(nullptr) {
+  std::lock_guard<std::mutex> lock(netcdf_mutex_);
+  ncfile_.open(_path, netCDF::NcFile::FileMode::replace);
+}
+
+DataLogger::DataLogger(const std::string& _path,
+                       const uint64_t& _queue_depth)
+    : ncfile_(),
+      groups_({}),
+      storage_({Node::kLogBufferSize, 1, true, false}),
+      queue_depth_(_queue_depth),
+      writing_(false),
+      stopping_(false),
+      error_(nullptr) {
+  {
+    std::lock_guard<std::mutex> lock(netcdf_mutex_);
+    ncfile_.open(_path, netCDF::NcFile::FileMode::replace);
+  }
+  if (queue_depth_ > 0) {
+    writer_ = std::thread(&DataLogger::Drain, this);
+  }
+}
+
+DataLogger::~DataLogger() {
+  if (writer_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      stopping_ = true;
+    }
+    queue_ready_.notify_one();
+    writer_.join();
+  }
+  if (error_ != nullptr) {
+    try {
+      std::rethrow_exception(error_);
+    } catch (const std::exception& e) {
+      std::cerr << e.what() << std::endl;
+    } catch (...) {
+      std::cerr << "DataLogger: background write failed" << std::endl;
+    }
+  }
+  // Close under the lock; the NcFile destructor would close without it
+  std::lock_guard<std::mutex> lock(netcdf_mutex_);
+  try {
+    ncfile_.close();
+  } catch (const netCDF::exceptions::NcException& e) {
+    std::cerr << e.what() << std::endl;
+  }
+}
+
+void DataLogger::Wait() {
+  {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    while (!queue_.empty() || writing_) {
+      queue_empty_.wait(lock);
+    }
+    Rethrow();
+  }
+  std::lock_guard<std::mutex> lock(netcdf_mutex_);
+  ncfile_.sync();
+}
+
+void DataLogger::Enqueue(std::unique_ptr<WriteRequest> _request) {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  Rethrow();
+  while (queue_.size() >= queue_depth_) {
+    queue_space_.wait(lock);
+  }
+  queue_.push_back(std::move(_request));
+  lock.unlock();
+  queue_ready_.notify_one();
+}
+
+void DataLogger::Rethrow() {
+  if (error_ != nullptr) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void DataLogger::Drain() {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  while (true) {
+    while (queue_.empty() && !stopping_) {
+      queue_ready_.wait(lock);
+    }
+    if (queue_.empty()) {
+      return;
+    }
+    std::unique_ptr<WriteRequest> request = std::move(queue_.front());
+    queue_.pop_front();
+    writing_ = true;
+    lock.unlock();
+    queue_space_.notify_one();
+    // Kept for Wait or the next Enqueue, since nothing here can handle it
+    std::exception_ptr error = nullptr;
+    try {
+      std::lock_guard<std::mutex> netcdf_lock(netcdf_mutex_);
+      request->Write();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock.lock();
+    if (error_ == nullptr) {
+      error_ = error;
+    }
+    writing_ = false;
+    if (queue_.empty()) {
+      queue_empty_.notify_all();
+    }
+  }
 }
 
 void DataLogger::Simulation(const uint16_t& _num_nodes,
                             const uint64_t& _ticks) {
+  std::lock_guard<std::mutex> lock(netcdf_mutex_);
   std::stringstream stream;
   for (uint16_t i = 0; i < _num_nodes; ++i) {
     stream << std::fixed << std::setw(6) << std::setfill('0') << i;
     groups_.push_back(ncfile_.addGroup(stream.str()));
     stream.str("");
   }
-  ncfile_.addDim("time", _ticks);
-  ncfile_.addVar("year", "int", "time");
-  ncfile_.addVar("month", "int", "time");
-  ncfile_.addVar("day", "int", "time");
-  ncfile_.addVar("hour", "int", "time");
-  ncfile_.addVar("minute", "int", "time");
-  ncfile_.addVar("second", "int", "time");
-  ncfile_.addVar("microsecond", "int", "time");
+  AddTimeDim("time", _ticks);
+  AddClock();
   for (auto group : groups_) {
-    group.addVar("area", "double", "time");
-    group.addVar("charging", "byte", "time");
-    group.addVar("constellation", "ushort", "time");
-    group.addVar("energy", "double", "time");
-    group.addVar("index", "ushort", "time");
-    group.addVar("latitude", "double", "time");
-    group.addVar("longitude", "double", "time");
-    group.addVar("altitude", "double", "time");
-    group.addVar("mode", "uint64", "time");
-    group.addVar("num_neighbors", "ushort", "time");
+    AddSeries(group, "area", "double", "time");
+    AddSeries(group, "charging", "byte", "time");
+    AddSeries(group, "constellation", "ushort", "time");
+    AddSeries(group, "energy", "double", "time");
+    AddSeries(group, "index", "ushort", "time");
+    AddSeries(group, "latitude", "double", "time");
+    AddSeries(group, "longitude", "double", "time");
+    AddSeries(group, "altitude", "double", "time");
+    AddSeries(group, "mode", "uint64", "time");
+    AddSeries(group, "num_neighbors", "ushort", "time");
   }
 }
 
+void DataLogger::SimulationMatrix(const uint16_t& _num_nodes,
+                                  const uint64_t& _ticks) {
+  std::lock_guard<std::mutex> lock(netcdf_mutex_);
+  ncfile_.addDim("node", _num_nodes);
+  AddTimeDim("time", _ticks);
+  AddClock();
+  AddMatrix("area", "double");
+  AddMatrix("charging", "byte");
+  AddMatrix("constellation", "ushort");
+  AddMatrix("energy", "double");
+  AddMatrix("index", "ushort");
+  AddMatrix("latitude", "double");
+  AddMatrix("longitude", "double");
+  AddMatrix("altitude", "double");
+  AddMatrix("mode", "uint64");
+  AddMatrix("num_neighbors", "ushort");
+}
+
 void DataLogger::Measurement(const uint64_t& _ticks) {
-  ncfile_.addDim("ticks", _ticks);
-  ncfile_.addVar("time", "uint64", "ticks");
-  ncfile_.addVar("year", "int", "ticks");
-  ncfile_.addVar("month", "int", "ticks");
-  ncfile_.addVar("day", "int", "ticks");
-  ncfile_.addVar("hour", "int", "ticks");
-  ncfile_.addVar("minute", "int", "ticks");
-  ncfile_.addVar("second", "int", "ticks");
-  ncfile_.addVar("microsecond", "int", "ticks");
-  ncfile_.addVar("latitude", "double", "ticks");
-  ncfile_.addVar("longitude", "double", "ticks");
-  ncfile_.addVar("altitude", "double", "ticks");
-  ncfile_.addVar("measurement", "double", "ticks");
-  ncfile_.addVar("resolution", "double", "ticks");
-  ncfile_.addVar("index", "ushort", "ticks");
+  std::lock_guard<std::mutex> lock(netcdf_mutex_);
+  AddTimeDim("ticks", _ticks);
+  AddSeries(ncfile_, "time", "uint64", "ticks");
+  AddSeries(ncfile_, "year", "int", "ticks");
+  AddSeries(ncfile_, "month", "int", "ticks");
+  AddSeries(ncfile_, "day", "int", "ticks");
+  AddSeries(ncfile_, "hour", "int", "ticks");
+  AddSeries(ncfile_, "minute", "int", "ticks");
+  AddSeries(ncfile_, "second", "int", "ticks");
+  AddSeries(ncfile_, "microsecond", "int", "ticks");
+  AddSeries(ncfile_, "latitude", "double", "ticks");
+  AddSeries(ncfile_, "longitude", "double", "ticks");
+  AddSeries(ncfile_, "altitude", "double", "ticks");
+  AddSeries(ncfile_, "measurement", "double", "ticks");
+  AddSeries(ncfile_, "resolution", "double", "ticks");
+  AddSeries(ncfile_, "index", "ushort", "ticks");
+}
+
+void DataLogger::RaggedMeasurement() {
+  std::lock_guard<std::mutex> lock(netcdf_mutex_);
+  ncfile_.putAtt("featureType", "trajectory");
+  ncfile_.addDim("obs");
+  ncfile_.addDim("instance");
+  netCDF::NcVar row_size = AddSeries(ncfile_, "row_size", "uint64", "instance");
+  row_size.putAtt("sample_dimension", "obs");
+  AddSeries(ncfile_, "node", "ushort", "instance");
+  AddSeries(ncfile_, "complete", "uint64", "instance");
+  AddSeries(ncfile_, "time", "uint64", "obs");
+  AddSeries(ncfile_, "year", "int", "obs");
+  AddSeries(ncfile_, "month", "int", "obs");
+  AddSeries(ncfile_, "day", "int", "obs");
+  AddSeries(ncfile_, "hour", "int", "obs");
+  AddSeries(ncfile_, "minute", "int", "obs");
+  AddSeries(ncfile_, "second", "int", "obs");
+  AddSeries(ncfile_, "microsecond", "int", "obs");
+  AddSeries(ncfile_, "latitude", "double", "obs");
+  AddSeries(ncfile_, "longitude", "double", "obs");
+  AddSeries(ncfile_, "altitude", "double", "obs");
+  AddSeries(ncfile_, "measurement", "double", "obs");
+  AddSeries(ncfile_, "resolution", "double", "obs");
+  AddSeries(ncfile_, "index", "ushort", "obs");
 }
 
 void DataLogger::Channel(const uint64_t& _ticks) {
-  ncfile_.addDim("ticks", _ticks);
-  ncfile_.addVar("time", "uint64", "ticks");
-  ncfile_.addVar("year", "int", "ticks");
-  ncfile_.addVar("month", "int", "ticks");
-  ncfile_.addVar("day", "int", "ticks");
-  ncfile_.addVar("hour", "int", "ticks");
-  ncfile_.addVar("minute", "int", "ticks");
-  ncfile_.addVar("second", "int", "ticks");
-  ncfile_.addVar("microsecond", "int", "ticks");
-  ncfile_.addVar("los_speed", "double", "ticks");
-  ncfile_.addVar("omega", "double", "ticks");
-  ncfile_.addVar("distance", "double", "ticks");
-  ncfile_.addVar("delay", "double", "ticks");
-  ncfile_.addVar("data_rate", "double", "ticks");
-  ncfile_.addVar("tx_idx", "double", "ticks");
-  ncfile_.addVar("tx_buffer", "uint64", "ticks");
-  ncfile_.addVar("tx_lon", "double", "ticks");
-  ncfile_.addVar("tx_lat", "double", "ticks");
-  ncfile_.addVar("tx_alt", "double", "ticks");
-  ncfile_.addVar("tx_gain", "double", "ticks");
-  ncfile_.addVar("tx_power", "double", "ticks");
-  ncfile_.addVar("rx_idx", "double", "ticks");
-  ncfile_.addVar("rx_buffer", "uint64", "ticks");
-  ncfile_.addVar("rx_lon", "double", "ticks");
-  ncfile_.addVar("rx_lat", "double", "ticks");
-  ncfile_.addVar("rx_alt", "double", "ticks");
-  ncfile_.addVar("rx_gain", "double", "ticks");
-  ncfile_.addVar("rx_power", "double", "ticks");
+  std::lock_guard<std::mutex> lock(netcdf_mutex_);
+  AddTimeDim("ticks", _ticks);
+  AddSeries(ncfile_, "time", "uint64", "ticks");
+  AddSeries(ncfile_, "year", "int", "ticks");
+  AddSeries(ncfile_, "month", "int", "ticks");
+  AddSeries(ncfile_, "day", "int", "ticks");
+  AddSeries(ncfile_, "hour", "int", "ticks");
+  AddSeries(ncfile_, "minute", "int", "ticks");
+  AddSeries(ncfile_, "second", "int", "ticks");
+  AddSeries(ncfile_, "microsecond", "int", "ticks");
+  AddSeries(ncfile_, "los_speed", "double", "ticks");
+  AddSeries(ncfile_, "omega", "double", "ticks");
+  AddSeries(ncfile_, "distance", "double", "ticks");
+  AddSeries(ncfile_, "delay", "double", "ticks");
+  AddSeries(ncfile_, "data_rate", "double", "ticks");
+  AddSeries(ncfile_, "tx_idx", "double", "ticks");
+  AddSeries(ncfile_, "tx_buffer", "uint64", "ticks");
+  AddSeries(ncfile_, "tx_lon", "double", "ticks");
+  AddSeries(ncfile_, "tx_lat", "double", "ticks");
+  AddSeries(ncfile_, "tx_alt", "double", "ticks");
+  AddSeries(ncfile_, "tx_gain", "double", "ticks");
+  AddSeries(ncfile_, "tx_power", "double", "ticks");
+  AddSeries(ncfile_, "rx_idx", "double", "ticks");
+  AddSeries(ncfile_, "rx_buffer", "uint64", "ticks");
+  AddSeries(ncfile_, "rx_lon", "double", "ticks");
+  AddSeries(ncfile_, "rx_lat", "double", "ticks");
+  AddSeries(ncfile_, "rx_alt", "double", "ticks");
+  AddSeries(ncfile_, "rx_gain", "double", "ticks");
+  AddSeries(ncfile_, "rx_power", "double", "ticks");
 }
 
 void DataLogger::UnweightedNetwork(const uint16_t& _num_nodes,
                                    const uint64_t& _ticks) {
-  ncfile_.addDim("time", _ticks);
+  std::lock_guard<std::mutex> lock(netcdf_mutex_);
+  AddTimeDim("time", _ticks);
   ncfile_.addDim("rx", _num_nodes);
   ncfile_.addDim("tx", _num_nodes);
-  ncfile_.addVar("edges", "byte", {"rx", "tx", "time"});
+  Store(ncfile_.addVar("edges", "byte", {"rx", "tx", "time"}),
+        {_num_nodes, _num_nodes, 1});
 }
 
 void DataLogger::WeightedNetwork(const uint16_t& _num_nodes,
                                  const uint64_t& _ticks) {
-  ncfile_.addDim("time", _ticks);
+  std::lock_guard<std::mutex> lock(netcdf_mutex_);
+  AddTimeDim("time", _ticks);
+  ncfile_.addDim("rx", _num_nodes);
+  ncfile_.addDim("tx", _num_nodes);
+  Store(ncfile_.addVar("edges", "double", {"rx", "tx", "time"}),
+        {_num_nodes, _num_nodes, 1});
+}
+
+void DataLogger::UnweightedEvents(const uint16_t& _num_nodes,
+                                  const uint64_t& _ticks) {
+  std::lock_guard<std::mutex> lock(netcdf_mutex_);
+  AddTimeDim("time", _ticks);
   ncfile_.addDim("rx", _num_nodes);
   ncfile_.addDim("tx", _num_nodes);
-  ncfile_.addVar("edges", "double", {"rx", "tx", "time"});
+  ncfile_.addDim("event");
+  ncfile_.addDim("snapshot");
+  AddSeries(ncfile_, "event_time", "uint64", "event");
+  AddSeries(ncfile_, "event_rx", "ushort", "event");
+  AddSeries(ncfile_, "event_tx", "ushort", "event");
+  AddSeries(ncfile_, "event_on", "byte", "event");
+  AddSeries(ncfile_, "snapshot_time", "uint64", "snapshot");
+  AddSeries(ncfile_, "snapshot_event", "uint64", "snapshot");
+  Store(ncfile_.addVar("snapshot_edges", "byte", {"snapshot", "rx", "tx"}),
+        {1, _num_nodes, _num_nodes});
+}
+
+netCDF::NcVar DataLogger::AddSeries(const netCDF::NcGroup& _group,
+                                    const std::string& _name,
+                                    const std::string& _type,
+                                    const std::string& _dim) const {
+  netCDF::NcVar variable = _group.addVar(_name, _type, _dim);
+  netCDF::NcDim dim = _group.getDim(_dim, netCDF::NcGroup::ParentsAndCurrent);
+  size_t length = storage_.chunk_length;
+  if (!dim.isUnlimited()) {
+    length = std::min(length, dim.getSize());
+  }
+  Store(variable, {length});
+  return variable;
+}
+
+void DataLogger::AddMatrix(const std::string& _name,
+                           const std::string& _type) const {
+  std::vector<std::string> dims {"node", "time"};
+  netCDF::NcVar variable = ncfile_.addVar(_name, _type, dims);
+  size_t length = storage_.chunk_length;
+  netCDF::NcDim time = ncfile_.getDim("time");
+  if (!time.isUnlimited()) {
+    length = std::min(length, time.getSize());
+  }
+  // One node per chunk, so a single node's history reads contiguously
+  Store(variable, {1, length});
+}
+
+void DataLogger::AddClock() {
+  ncfile_.addDim("step");
+  AddSeries(ncfile_, "step_tick", "uint64", "step");
+  AddSeries(ncfile_, "step_s", "uint64", "step");
+  AddSeries(ncfile_, "year", "int", "step");
+  AddSeries(ncfile_, "month", "int", "step");
+  AddSeries(ncfile_, "day", "int", "step");
+  AddSeries(ncfile_, "hour", "int", "step");
+  AddSeries(ncfile_, "minute", "int", "step");
+  AddSeries(ncfile_, "second", "int", "step");
+  AddSeries(ncfile_, "microsecond", "int", "step");
+}
+
+void DataLogger::AddTimeDim(const std::string& _name, const uint64_t& _ticks) {
+  if (storage_.unlimited) {
+    ncfile_.addDim(_name);
+  } else {
+    ncfile_.addDim(_name, _ticks);
+  }
+}
+
+void DataLogger::Store(const netCDF::NcVar& _variable,
+                      std::vector<size_t> _chunks) const {
+  for (auto& chunk : _chunks) {
+    chunk = std::max<size_t>(chunk, 1);
+  }
+  _variable.setChunking(netCDF::NcVar::nc_CHUNKED, _chunks);
+  if (storage_.shuffle || (storage_.deflate_level > 0)) {
+    _variable.setCompression(storage_.shuffle,
+                             storage_.deflate_level > 0,
+                             storage_.deflate_level);
+  }
 }
 
 void DataLogger::LogDateTime(const std::string& _variable,
                              const int* _values,
                              const uint64_t& _index,
                              const uint64_t& _count) {
-  netCDF::NcVar variable = ncfile_.getVar(_variable);
-  variable.putVar({_index}, {_count}, _values);
+  Write(ncfile_, _variable, {_index}, {_count}, _values);
 }
 
 void DataLogger::LogAntenna(const uint64_t& _theta_ticks,
                             const uint64_t& _phi_ticks,
                             const double* _gain_array) {
+  std::lock_guard<std::mutex> lock(netcdf_mutex_);
   ncfile_.addDim("theta", _theta_ticks);
   ncfile_.addDim("phi", _phi_ticks);
   std::vector<std::string> dims {"theta", "phi"};
@@ -147,15 +398,27 @@ void DataLogger::LogAntenna(const uint64_t& _theta_ticks,
 void DataLogger::LogUnweightedGraph(const uint64_t& _tick,
                                     const bool* _edges,
                                     const uint16_t _num_nodes) {
-  netCDF::NcVar edges = ncfile_.getVar("edges");
-  edges.putVar({0, 0, _tick}, {_num_nodes, _num_nodes, 1}, _edges);
+  Write(ncfile_, "edges", {0, 0, _tick}, {_num_nodes, _num_nodes, 1}, _edges);
+}
+
+void DataLogger::LogUnweightedSnapshot(const uint64_t& _index,
+                                       const uint64_t& _tick,
+                                       const uint64_t& _num_events,
+                                       const bool* _edges,
+                                       const uint16_t _num_nodes) {
+  LogSeries("snapshot_time", &_tick, _index, 1);
+  LogSeries("snapshot_event", &_num_events, _index, 1);
+  Write(ncfile_,
+        "snapshot_edges",
+        {_index, 0, 0},
+        {1, _num_nodes, _num_nodes},
+        _edges);
 }
 
 void DataLogger::LogWeightedGraph(const uint64_t& _tick,
                                   const double* _edges,
                                   const uint16_t _num_nodes) {
-  netCDF::NcVar edges = ncfile_.getVar("edges");
-  edges.putVar({0, 0, _tick}, {_num_nodes, _num_nodes, 1}, _edges);
+  Write(ncfile_, "edges", {0, 0, _tick}, {_num_nodes, _num_nodes, 1}, _edges);
 }
 
 void DataLogger::LogCommunication() {
@@ -33,7 +33,7 @@ DataProcessorSink::DataProcessorSink() : DataProcessor() {
 }
 
 void DataProcessorSink::Compute(
-    const std::vector<PacketRaw>& _raw_packets,
+    const std::vector<PacketRawView>& _raw_packets,
     const uint16_t& _source_index,
     const SimulationClock& _clock,
     std::vector<Geodetic>* _min_list,
@@ -48,7 +48,7 @@ void DataProcessorSink::Compute(
   constexpr double rain_threshold = 0.000005;
   constexpr double opt_threshold = 1;
   if (_raw_packets.size() > 0) {
-    PacketRaw middle = _raw_packets[static_cast<int>(_raw_packets.size()/2)];
+    PacketRawView middle = _raw_packets[_raw_packets.size() / 2];
     double measurement = middle.measurement();
     bool is_rain = false;
     if (middle.name().find("PRECTOT") != std::string::npos) {
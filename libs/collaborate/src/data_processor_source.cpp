@@ -43,7 +43,7 @@ DataProcessorSource::DataProcessorSource(const bool& _flag)
 }
 
 void DataProcessorSource::Compute(
-    const std::vector<PacketRaw>& _raw_packets,
+    const std::vector<PacketRawView>& _raw_packets,
     const uint16_t& _source_index,
     const SimulationClock& _clock,
     std::vector<Geodetic>* _min_list,
@@ -31,7 +31,7 @@ DataProcessorTemplate::DataProcessorTemplate() : DataProcessor() {
 }
 
 void DataProcessorTemplate::Compute(
-    const std::vector<PacketRaw>& _raw_packets,
+    const std::vector<PacketRawView>& _raw_packets,
     const uint16_t& _source_index,
     const SimulationClock& _clock,
     std::vector<Geodetic>* _min_list,
@@ -17,88 +17,549 @@
 
 #include <experimental/filesystem>
 
-#include <array>
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <functional>
+#include <future>
+#include <iostream>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "netcdf/ncFile.h"
 #include "netcdf/ncVar.h"
+#include "netcdf/ncVarAtt.h"
 
+#include "collaborate/data_logger.h"
 #include "collaborate/earth.h"
+#include "collaborate/earth_tiles.h"
 #include "collaborate/simulation_clock.h"
 #include "collaborate/util.h"
 
 namespace osse {
 namespace collaborate {
 
+constexpr uint64_t EarthData::kRowsPerRead;
+constexpr uint64_t EarthData::kResolutionS;
+constexpr double EarthData::kCellRadiusM;
+constexpr uint16_t EarthData::kFillCode;
+
+std::map<EarthData::Key, std::weak_ptr<const EarthData::Frame>>
+    EarthData::frames_;
+std::map<EarthData::Key,
+         std::shared_future<std::shared_ptr<const EarthData::Frame>>>
+    EarthData::loading_;
+std::map<std::string, EarthData::kStorage> EarthData::variables_;
+std::set<std::string> EarthData::footprints_;
+std::mutex EarthData::frames_mutex_;
+
 EarthData::EarthData(const std::string& _root)
     : data_paths_(FindDataPaths(_root)),
       current_index_(std::numeric_limits<uint64_t>::max()),
-      kData_({0}) {
+      bilinear_(false),
+      temporal_(false),
+      weight_(0),
+      data_(nullptr),
+      later_(nullptr),
+      later_index_(std::numeric_limits<uint64_t>::max()),
+      next_index_(std::numeric_limits<uint64_t>::max()),
+      next_() {
 }
 
 void EarthData::Update(const SimulationClock& _simulation_clock,
                        const std::string& _variable) {
-  constexpr uint64_t kResolutionS_ = 1800;
-  uint64_t index = _simulation_clock.elapsed_s() / kResolutionS_;
+  uint64_t index = _simulation_clock.elapsed_s() / kResolutionS;
   if (index != current_index_) {
     current_index_ = index;
     if (data_paths_.size() > current_index_) {
       Buffer(_variable);
     }
   }
+  weight_ = static_cast<double>(_simulation_clock.elapsed_s() % kResolutionS)
+            / kResolutionS;
+}
+
+void EarthData::Track(const std::string& _variable) {
+  std::lock_guard<std::mutex> lock(frames_mutex_);
+  variables_.insert({_variable, kStorage::Float});
+}
+
+void EarthData::Track(const std::string& _variable,
+                      const kStorage& _storage) {
+  std::lock_guard<std::mutex> lock(frames_mutex_);
+  variables_[_variable] = _storage;
+}
+
+void EarthData::TrackFootprint(const std::string& _variable) {
+  std::lock_guard<std::mutex> lock(frames_mutex_);
+  footprints_.insert(_variable);
 }
 
 void EarthData::Buffer(const std::string& _variable) {
-  std::string current_path = data_paths_.at(current_index_);
-  netCDF::NcFile file(current_path, netCDF::NcFile::read);
-  netCDF::NcVar var = file.getVar(_variable);
-  var.getVar({0, 0, 0},
-             {1, earth::kNumLats, earth::kNumLons},
-             kData_.data());
+  std::shared_ptr<const Slice> data = Take(current_index_, _variable);
+  std::shared_ptr<const Slice> later = nullptr;
+  if (temporal_) {
+    later = Take(current_index_ + 1, _variable);
+  }
+  data_ = data;
+  later_ = later;
+  later_index_ = current_index_ + 1;
+  Prefetch(current_index_ + (temporal_ ? 2 : 1), _variable);
+}
+
+std::shared_ptr<const EarthData::Slice> EarthData::Take(
+    const uint64_t& _index,
+    const std::string& _variable) {
+  if (data_paths_.size() <= _index) {
+    return nullptr;
+  }
+  if ((later_ != nullptr) && (later_index_ == _index)) {
+    return later_;
+  }
+  if (next_.valid() && (next_index_ == _index)) {
+    return next_.get();
+  }
+  return Acquire(Key(data_paths_[_index], _index), _variable);
+}
+
+void EarthData::Prefetch(const uint64_t& _index,
+                         const std::string& _variable) {
+  // Replacing a pending prefetch (after a jump in time) waits for it
+  next_index_ = _index;
+  if (data_paths_.size() <= next_index_) {
+    next_ = std::future<std::shared_ptr<const Slice>>();
+    return;
+  }
+  next_ = std::async(std::launch::async,
+                     &EarthData::Acquire,
+                     Key(data_paths_[next_index_], next_index_),
+                     _variable);
+}
+
+std::shared_ptr<const EarthData::Slice> EarthData::Acquire(
+    const Key& _key,
+    const std::string& _variable) {
+  std::unique_lock<std::mutex> lock(frames_mutex_);
+  while (true) {
+    std::shared_ptr<const Frame> frame = frames_[_key].lock();
+    if ((frame != nullptr) && (frame->slices.count(_variable) > 0)) {
+      return std::shared_ptr<const Slice>(frame,
+                                          &frame->slices.at(_variable));
+    }
+    if (loading_.count(_key) == 0) {
+      break;
+    }
+    // Wait for the load already in flight rather than repeat it
+    std::shared_future<std::shared_ptr<const Frame>> pending =
+        loading_.at(_key);
+    lock.unlock();
+    frame = pending.get();
+    lock.lock();
+    if (frame->slices.count(_variable) > 0) {
+      return std::shared_ptr<const Slice>(frame,
+                                          &frame->slices.at(_variable));
+    }
+  }
+  std::map<std::string, kStorage> variables = variables_;
+  variables.insert({_variable, kStorage::Float});
+  std::set<std::string> footprints = footprints_;
+  std::promise<std::shared_ptr<const Frame>> promise;
+  loading_[_key] = promise.get_future().share();
+  lock.unlock();
+  std::shared_ptr<const Frame> loaded = nullptr;
+  try {
+    loaded = Load(_key.first, variables, footprints);
+  } catch (...) {
+    lock.lock();
+    loading_.erase(_key);
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+  lock.lock();
+  // Forget frames that every holder has released
+  for (auto it = frames_.begin(); it != frames_.end();) {
+    if (it->second.expired()) {
+      it = frames_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  frames_[_key] = loaded;
+  loading_.erase(_key);
+  promise.set_value(loaded);
+  lock.unlock();
+  if (loaded->slices.count(_variable) == 0) {
+    std::cerr << "EarthData: " << _key.first << " has no variable "
+              << _variable << std::endl;
+    throw std::runtime_error("EarthData: missing variable " + _variable);
+  }
+  return std::shared_ptr<const Slice>(loaded, &loaded->slices.at(_variable));
+}
+
+std::shared_ptr<EarthData::Frame> EarthData::Load(
+    const std::string& _path,
+    const std::map<std::string, kStorage>& _variables,
+    const std::set<std::string>& _footprints) {
+  std::shared_ptr<Frame> frame = std::make_shared<Frame>();
+  std::vector<std::string> unmapped;
+  for (auto& variable : _variables) {
+    Slice& slice = frame->slices[variable.first];
+    slice.storage = kStorage::Float;
+    std::string tiles_path = EarthTiles::Path(_path, variable.first);
+    if (std::experimental::filesystem::exists(tiles_path)) {
+      // Tiles older than their source would serve outdated values
+      if (std::experimental::filesystem::last_write_time(tiles_path)
+          < std::experimental::filesystem::last_write_time(_path)) {
+        std::cerr << tiles_path << ": older than " << _path << std::endl;
+      } else {
+        slice.tiles.reset(new EarthTiles(tiles_path));
+        if (!slice.tiles->valid()) {
+          slice.tiles.reset();
+        }
+      }
+    }
+    if (slice.tiles == nullptr) {
+      unmapped.push_back(variable.first);
+    }
+  }
+  if (!unmapped.empty()) {
+    // One open for every variable still to read
+    std::unique_lock<std::mutex> netcdf_lock(DataLogger::netcdf_mutex());
+    netCDF::NcFile file(_path, netCDF::NcFile::read);
+    std::vector<float> values;
+    for (auto& variable : unmapped) {
+      if (!netcdf_lock.owns_lock()) {
+        netcdf_lock.lock();
+      }
+      netCDF::NcVar var = file.getVar(variable);
+      if (var.isNull()) {
+        // Tracked for other files; Acquire fails if it was the one asked for
+        frame->slices.erase(variable);
+        continue;
+      }
+      Slice& slice = frame->slices[variable];
+      kStorage storage = _variables.at(variable);
+      std::vector<float> fills;
+      if (storage != kStorage::Float) {
+        for (auto& attribute : var.getAtts()) {
+          if ((attribute.first == "_FillValue")
+              || (attribute.first == "missing_value")) {
+            std::vector<float> fill(attribute.second.getAttLength());
+            attribute.second.getValues(fill.data());
+            fills.insert(fills.end(), fill.begin(), fill.end());
+          }
+        }
+      }
+      float* target = nullptr;
+      if (storage == kStorage::Float) {
+        slice.values.resize(earth::kNumPositions);
+        target = slice.values.data();
+      } else {
+        // Read whole, since quantizing needs the slice's range
+        values.resize(earth::kNumPositions);
+        target = values.data();
+      }
+      for (uint64_t row = 0; row < earth::kNumLats; row += kRowsPerRead) {
+        uint64_t rows = std::min(kRowsPerRead, earth::kNumLats - row);
+        if (!netcdf_lock.owns_lock()) {
+          netcdf_lock.lock();
+        }
+        var.getVar({0, row, 0},
+                   {1, rows, earth::kNumLons},
+                   target + util::Index(row, 0, earth::kNumLons));
+        netcdf_lock.unlock();
+      }
+      if (storage != kStorage::Float) {
+        Encode(values, fills, storage, &slice);
+      }
+    }
+    // Relock (unless a skipped variable left it held), since the file
+    // closes when it goes out of scope
+    if (!netcdf_lock.owns_lock()) {
+      netcdf_lock.lock();
+    }
+  }
+  for (auto& variable : _footprints) {
+    auto slice = frame->slices.find(variable);
+    if (slice != frame->slices.end()) {
+      std::call_once(slice->second.summed,
+                     &EarthData::Summarize,
+                     std::cref(slice->second));
+    }
+  }
+  return frame;
+}
+
+void EarthData::Encode(const std::vector<float>& _values,
+                       const std::vector<float>& _fills,
+                       const kStorage& _storage,
+                       Slice* _slice) {
+  constexpr float kMaxCode = kFillCode - 1;
+  // Fill values (often near 1e37) would swamp the range of the real data
+  std::vector<bool> missing(_values.size());
+  for (uint64_t i = 0; i < _values.size(); ++i) {
+    missing[i] = !std::isfinite(_values[i])
+                 || (std::find(_fills.begin(), _fills.end(), _values[i])
+                     != _fills.end());
+  }
+  _slice->storage = _storage;
+  _slice->scale = 1;
+  _slice->offset = 0;
+  _slice->codes.resize(_values.size());
+  if (_storage == kStorage::Half) {
+    uint16_t nan = util::HalfFromFloat(std::numeric_limits<float>::quiet_NaN());
+    for (uint64_t i = 0; i < _values.size(); ++i) {
+      _slice->codes[i] = missing[i] ? nan : util::HalfFromFloat(_values[i]);
+    }
+    return;
+  }
+  float minimum = std::numeric_limits<float>::max();
+  float maximum = std::numeric_limits<float>::lowest();
+  for (uint64_t i = 0; i < _values.size(); ++i) {
+    if (!missing[i]) {
+      minimum = std::min(minimum, _values[i]);
+      maximum = std::max(maximum, _values[i]);
+    }
+  }
+  if (minimum > maximum) {
+    minimum = 0;
+    maximum = 0;
+  }
+  _slice->offset = minimum;
+  if (maximum > minimum) {
+    _slice->scale = (maximum - minimum) / kMaxCode;
+  }
+  for (uint64_t i = 0; i < _values.size(); ++i) {
+    if (missing[i]) {
+      _slice->codes[i] = kFillCode;
+    } else {
+      float code = std::round((_values[i] - minimum) / _slice->scale);
+      _slice->codes[i] = std::min(std::max(code, 0.0f), kMaxCode);
+    }
+  }
 }
 
 float EarthData::Measure(const double& _latitude_rad,
                          const double& _longitude_rad) const {
-  return kData_[util::Index(IndexLatitude(_latitude_rad),
-                            IndexLongitude(_longitude_rad),
-                            earth::kNumLons)];
+  return Blend(bilinear_, _latitude_rad, _longitude_rad);
+}
+
+float EarthData::MeasureFootprint(const double& _latitude_rad,
+                                  const double& _longitude_rad,
+                                  const double& _radius_m) const {
+  if (_radius_m <= 0) {
+    return Measure(_latitude_rad, _longitude_rad);
+  }
+  if (data_ == nullptr) {
+    return 0;
+  }
+  float value = Footprint(*data_, _latitude_rad, _longitude_rad, _radius_m);
+  if (temporal_ && (later_ != nullptr) && (weight_ > 0)) {
+    value = (1 - weight_) * value
+            + weight_ * Footprint(*later_,
+                                  _latitude_rad,
+                                  _longitude_rad,
+                                  _radius_m);
+  }
+  return value;
 }
 
-uint16_t EarthData::IndexLatitude(const double& _latitude_rad) const {
-  double latitude_rad = -1 * util::kPiByTwoRad;
-  uint16_t index = 0;
-  bool flag = false;
-  while (index < earth::kNumLats && !flag) {
-    if (latitude_rad > _latitude_rad) {
-      flag = true;
+void EarthData::Measure(const std::vector<double>& _latitudes_rad,
+                        const std::vector<double>& _longitudes_rad,
+                        const std::vector<double>& _radii_m,
+                        std::vector<float>* _samples) const {
+  uint64_t count = _latitudes_rad.size();
+  _samples->assign(count, 0);
+  if (data_ == nullptr) {
+    return;
+  }
+  bool blend = temporal_ && (later_ != nullptr) && (weight_ > 0);
+  for (uint64_t i = 0; i < count; ++i) {
+    if (_radii_m[i] > 0) {
+      (*_samples)[i] = Footprint(*data_,
+                                 _latitudes_rad[i],
+                                 _longitudes_rad[i],
+                                 _radii_m[i]);
+      if (blend) {
+        (*_samples)[i] = (1 - weight_) * (*_samples)[i]
+                         + weight_ * Footprint(*later_,
+                                               _latitudes_rad[i],
+                                               _longitudes_rad[i],
+                                               _radii_m[i]);
+      }
+    } else {
+      (*_samples)[i] = Sample(*data_,
+                              bilinear_,
+                              _latitudes_rad[i],
+                              _longitudes_rad[i]);
+      if (blend) {
+        (*_samples)[i] = (1 - weight_) * (*_samples)[i]
+                         + weight_ * Sample(*later_,
+                                            bilinear_,
+                                            _latitudes_rad[i],
+                                            _longitudes_rad[i]);
+      }
     }
-    latitude_rad += earth::kLatIncrementRad;
-    ++index;
   }
-  return index;
 }
 
-uint16_t EarthData::IndexLongitude(const double& _longitude_rad) const {
-  double longitude_rad = -1 * util::kPiRad;
-  uint16_t index = 0;
-  bool flag = false;
-  while (index < earth::kNumLons && !flag) {
-    if (longitude_rad > _longitude_rad) {
-      flag = true;
+float EarthData::MeasureBilinear(const double& _latitude_rad,
+                                 const double& _longitude_rad) const {
+  return Blend(true, _latitude_rad, _longitude_rad);
+}
+
+float EarthData::Blend(const bool& _bilinear,
+                       const double& _latitude_rad,
+                       const double& _longitude_rad) const {
+  if (data_ == nullptr) {
+    return 0;
+  }
+  float value = Sample(*data_, _bilinear, _latitude_rad, _longitude_rad);
+  if (temporal_ && (later_ != nullptr) && (weight_ > 0)) {
+    value = (1 - weight_) * value
+            + weight_ * Sample(*later_,
+                               _bilinear,
+                               _latitude_rad,
+                               _longitude_rad);
+  }
+  return value;
+}
+
+float EarthData::Sample(const Slice& _slice,
+                        const bool& _bilinear,
+                        const double& _latitude_rad,
+                        const double& _longitude_rad) {
+  if (!_bilinear) {
+    return Cell(_slice,
+                IndexLatitude(_latitude_rad),
+                IndexLongitude(_longitude_rad));
+  }
+  // Continuous indices, so sample i sits at i (see IndexLatitude)
+  double row = (_latitude_rad + util::kPiByTwoRad) / earth::kLatIncrementRad
+               + 1.5;
+  double column = (_longitude_rad + util::kPiRad) / earth::kLonIncrementRad
+                  + 1.5;
+  double max_row = earth::kNumLats - 1;
+  row = std::min(std::max(row, 0.0), max_row);
+  int64_t row_0 = std::min(static_cast<int64_t>(std::floor(row)),
+                           static_cast<int64_t>(earth::kNumLats - 2));
+  int64_t column_0 = static_cast<int64_t>(std::floor(column));
+  double row_weight = row - row_0;
+  double column_weight = column - column_0;
+  int64_t num_lons = earth::kNumLons;
+  uint64_t west = ((column_0 % num_lons) + num_lons) % num_lons;
+  uint64_t east = (west + 1) % num_lons;
+  double south = (1 - column_weight) * Cell(_slice, row_0, west)
+                 + column_weight * Cell(_slice, row_0, east);
+  double north = (1 - column_weight) * Cell(_slice, row_0 + 1, west)
+                 + column_weight * Cell(_slice, row_0 + 1, east);
+  return (1 - row_weight) * south + row_weight * north;
+}
+
+float EarthData::Footprint(const Slice& _slice,
+                           const double& _latitude_rad,
+                           const double& _longitude_rad,
+                           const double& _radius_m) {
+  std::call_once(_slice.summed, &EarthData::Summarize, std::cref(_slice));
+  // Cells within the radius of the nearest one, in each direction
+  double cos_latitude = std::max(std::cos(_latitude_rad),
+                                 earth::kLatIncrementRad);
+  uint64_t rows = std::llround(_radius_m / (earth::kSemiMajorAxisM
+                                            * earth::kLatIncrementRad));
+  uint64_t columns = std::llround(_radius_m / (earth::kSemiMajorAxisM
+                                               * cos_latitude
+                                               * earth::kLonIncrementRad));
+  uint64_t row = IndexLatitude(_latitude_rad);
+  uint64_t column = IndexLongitude(_longitude_rad);
+  uint64_t first_row = (row > rows) ? (row - rows) : 0;
+  uint64_t last_row = std::min(row + rows, earth::kNumLats - 1);
+  double sum;
+  uint64_t width;
+  if (2 * columns + 1 >= earth::kNumLons) {
+    width = earth::kNumLons;
+    sum = BoxSum(_slice.sums, first_row, last_row, 0, earth::kNumLons - 1);
+  } else {
+    // Wrap around the antimeridian
+    width = 2 * columns + 1;
+    uint64_t first_column = (column + earth::kNumLons - columns)
+                            % earth::kNumLons;
+    uint64_t last_column = (column + columns) % earth::kNumLons;
+    if (first_column <= last_column) {
+      sum = BoxSum(_slice.sums,
+                   first_row,
+                   last_row,
+                   first_column,
+                   last_column);
+    } else {
+      sum = BoxSum(_slice.sums,
+                   first_row,
+                   last_row,
+                   first_column,
+                   earth::kNumLons - 1)
+            + BoxSum(_slice.sums, first_row, last_row, 0, last_column);
     }
-    longitude_rad += earth::kLonIncrementRad;
-    ++index;
   }
-  return index;
+  return sum / ((last_row - first_row + 1) * width);
+}
+
+double EarthData::BoxSum(const std::vector<double>& _sums,
+                         const uint64_t& _first_row,
+                         const uint64_t& _last_row,
+                         const uint64_t& _first_column,
+                         const uint64_t& _last_column) {
+  constexpr uint64_t kWidth = earth::kNumLons + 1;
+  return _sums[util::Index(_last_row + 1, _last_column + 1, kWidth)]
+         - _sums[util::Index(_first_row, _last_column + 1, kWidth)]
+         - _sums[util::Index(_last_row + 1, _first_column, kWidth)]
+         + _sums[util::Index(_first_row, _first_column, kWidth)];
+}
+
+void EarthData::Summarize(const Slice& _slice) {
+  constexpr uint64_t kWidth = earth::kNumLons + 1;
+  _slice.sums.assign((earth::kNumLats + 1) * kWidth, 0);
+  for (uint64_t row = 0; row < earth::kNumLats; ++row) {
+    double row_sum = 0;
+    for (uint64_t column = 0; column < earth::kNumLons; ++column) {
+      float value = Cell(_slice, row, column);
+      if (std::isfinite(value)) {
+        row_sum += value;
+      }
+      _slice.sums[util::Index(row + 1, column + 1, kWidth)] =
+          _slice.sums[util::Index(row, column + 1, kWidth)] + row_sum;
+    }
+  }
+}
+
+int64_t EarthData::GridLine(const double& _offset_rad,
+                            const double& _increment_rad) {
+  if (_offset_rad < 0) {
+    return -1;
+  }
+  return static_cast<int64_t>(std::floor(_offset_rad / _increment_rad));
+}
+
+uint16_t EarthData::IndexLatitude(const double& _latitude_rad) {
+  // The first grid line above the latitude is one past the line below it
+  int64_t index = GridLine(_latitude_rad + util::kPiByTwoRad,
+                           earth::kLatIncrementRad) + 2;
+  return std::min(index, static_cast<int64_t>(earth::kNumLats - 1));
+}
+
+uint16_t EarthData::IndexLongitude(const double& _longitude_rad) {
+  int64_t index = GridLine(_longitude_rad + util::kPiRad,
+                           earth::kLonIncrementRad) + 2;
+  return std::min(index, static_cast<int64_t>(earth::kNumLons - 1));
 }
 
-std::vector<std::string> EarthData::FindDataPaths(
-    const std::string& _root) const {
+std::vector<std::string> EarthData::FindDataPaths(const std::string& _root) {
   std::vector<std::string> data_paths;
   std::experimental::filesystem::path root(_root);
   for (auto path : std::experimental::filesystem::directory_iterator(root)) {
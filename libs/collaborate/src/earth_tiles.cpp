@@ -0,0 +1,159 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "collaborate/earth_tiles.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <experimental/filesystem>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "netcdf/ncException.h"
+#include "netcdf/ncFile.h"
+#include "netcdf/ncVar.h"
+
+#include "collaborate/data_logger.h"
+#include "collaborate/earth.h"
+
+namespace osse {
+namespace collaborate {
+
+constexpr char EarthTiles::kMagic[8];
+constexpr uint64_t EarthTiles::kTileSize;
+
+EarthTiles::EarthTiles(const std::string& _path)
+    : data_(nullptr),
+      size_(0),
+      tiles_(nullptr),
+      tiles_per_row_((earth::kNumLons + kTileSize - 1) / kTileSize) {
+  int file = open(_path.c_str(), O_RDONLY);
+  if (file < 0) {
+    std::cerr << _path << ": " << std::strerror(errno) << std::endl;
+    return;
+  }
+  uint64_t tiles_per_column = (earth::kNumLats + kTileSize - 1) / kTileSize;
+  uint64_t expected = kAlignment + tiles_per_column * tiles_per_row_
+                                   * kTileSize * kTileSize * sizeof(float);
+  struct stat status;
+  if ((fstat(file, &status) != 0)
+      || (static_cast<uint64_t>(status.st_size) != expected)) {
+    std::cerr << _path << ": not a tile file for this grid" << std::endl;
+    close(file);
+    return;
+  }
+  void* data = mmap(nullptr, expected, PROT_READ, MAP_SHARED, file, 0);
+  close(file);
+  if (data == MAP_FAILED) {
+    std::cerr << _path << ": " << std::strerror(errno) << std::endl;
+    return;
+  }
+  data_ = data;
+  size_ = expected;
+  Header header;
+  std::memcpy(&header, data_, sizeof(header));
+  if ((std::memcmp(header.magic, kMagic, sizeof(header.magic)) != 0)
+      || (header.version != kVersion)
+      || (header.tile_size != kTileSize)
+      || (header.num_lats != earth::kNumLats)
+      || (header.num_lons != earth::kNumLons)) {
+    std::cerr << _path << ": not a tile file for this grid" << std::endl;
+    return;
+  }
+  // Samples follow satellite ground tracks, so skip read-ahead
+  madvise(data_, size_, MADV_RANDOM);
+  tiles_ = reinterpret_cast<const float*>(static_cast<char*>(data_)
+                                          + kAlignment);
+}
+
+EarthTiles::~EarthTiles() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+}
+
+std::string EarthTiles::Path(const std::string& _netcdf_path,
+                             const std::string& _variable) {
+  std::experimental::filesystem::path path(_netcdf_path);
+  path.replace_extension("." + _variable + ".tiles");
+  return path.string();
+}
+
+bool EarthTiles::Convert(const std::string& _netcdf_path,
+                         const std::string& _variable,
+                         const std::string& _tiles_path) {
+  std::vector<float> grid(earth::kNumPositions);
+  try {
+    std::lock_guard<std::mutex> lock(DataLogger::netcdf_mutex());
+    netCDF::NcFile file(_netcdf_path, netCDF::NcFile::read);
+    netCDF::NcVar var = file.getVar(_variable);
+    var.getVar({0, 0, 0}, {1, earth::kNumLats, earth::kNumLons}, grid.data());
+  } catch (const netCDF::exceptions::NcException& e) {
+    std::cerr << _netcdf_path << ": " << e.what() << std::endl;
+    return false;
+  }
+  std::ofstream ofstream(_tiles_path,
+                         std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!ofstream) {
+    std::cerr << _tiles_path << ": " << std::strerror(errno) << std::endl;
+    return false;
+  }
+  Header header = {};
+  std::memcpy(header.magic, kMagic, sizeof(header.magic));
+  header.version = kVersion;
+  header.tile_size = kTileSize;
+  header.num_lats = earth::kNumLats;
+  header.num_lons = earth::kNumLons;
+  std::vector<char> preamble(kAlignment, 0);
+  std::memcpy(preamble.data(), &header, sizeof(header));
+  ofstream.write(preamble.data(), preamble.size());
+  std::vector<float> tile(kTileSize * kTileSize);
+  for (uint64_t row = 0; row < earth::kNumLats; row += kTileSize) {
+    for (uint64_t column = 0; column < earth::kNumLons; column += kTileSize) {
+      std::fill(tile.begin(), tile.end(), 0);
+      uint64_t rows = std::min(kTileSize, earth::kNumLats - row);
+      uint64_t columns = std::min(kTileSize, earth::kNumLons - column);
+      for (uint64_t r = 0; r < rows; ++r) {
+        std::copy_n(&grid[(row + r) * earth::kNumLons + column],
+                    columns,
+                    &tile[r * kTileSize]);
+      }
+      ofstream.write(reinterpret_cast<const char*>(tile.data()),
+                     tile.size() * sizeof(float));
+    }
+  }
+  // Close first, so an error flushing the last tiles is reported too
+  ofstream.close();
+  if (!ofstream) {
+    std::cerr << _tiles_path << ": write failed" << std::endl;
+    std::experimental::filesystem::remove(_tiles_path);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace collaborate
+}  // namespace osse
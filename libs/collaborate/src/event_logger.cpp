@@ -15,21 +15,73 @@
 
 #include "collaborate/event_logger.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "spdlog/async_logger.h"
+#include "spdlog/details/thread_pool.h"
 #include "spdlog/fmt/ostr.h"
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/spdlog.h"
 
+#include "collaborate/simulation_clock.h"
+
 namespace osse {
 namespace collaborate {
 
 EventLogger::EventLogger(const std::string& _path)
     : console_(std::make_shared<spdlog::sinks::stdout_color_sink_mt>()),
       file_(std::make_shared<spdlog::sinks::basic_file_sink_mt>(_path, true)),
-      log_(new spdlog::logger("collaborate", {console_, file_})) {
+      thread_pool_(nullptr),
+      log_(new spdlog::logger("collaborate", {console_, file_})),
+      render_(true) {
+}
+
+EventLogger::EventLogger(const std::string& _path, const bool& _console)
+    : console_(nullptr),
+      file_(std::make_shared<spdlog::sinks::basic_file_sink_mt>(_path, true)),
+      thread_pool_(nullptr),
+      log_(nullptr),
+      render_(true) {
+  std::vector<spdlog::sink_ptr> sinks = Sinks(_console);
+  log_ = std::make_shared<spdlog::logger>("collaborate",
+                                          sinks.begin(),
+                                          sinks.end());
+}
+
+EventLogger::EventLogger(const std::string& _path,
+                         const bool& _console,
+                         const size_t& _queue_size,
+                         const spdlog::async_overflow_policy& _overflow)
+    : console_(nullptr),
+      file_(std::make_shared<spdlog::sinks::basic_file_sink_mt>(_path, true)),
+      thread_pool_(std::make_shared<spdlog::details::thread_pool>(_queue_size,
+                                                                  1)),
+      log_(nullptr),
+      render_(true) {
+  std::vector<spdlog::sink_ptr> sinks = Sinks(_console);
+  log_ = std::make_shared<spdlog::async_logger>("collaborate",
+                                                sinks.begin(),
+                                                sinks.end(),
+                                                thread_pool_,
+                                                _overflow);
+}
+
+std::vector<spdlog::sink_ptr> EventLogger::Sinks(const bool& _console) {
+  std::vector<spdlog::sink_ptr> sinks;
+  if (_console) {
+    console_ = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    sinks.push_back(console_);
+  }
+  sinks.push_back(file_);
+  return sinks;
 }
 
 void EventLogger::Initialize(const std::string& _level,
@@ -50,20 +102,22 @@ void EventLogger::Initialize(const std::string& _level,
   } else if (_level == "critical") {
     log_->set_level(spdlog::level::critical);
   }
-  if (_console_level == "off") {
-    console_->set_level(spdlog::level::off);
-  } else if (_console_level == "trace") {
-    console_->set_level(spdlog::level::trace);
-  } else if (_console_level == "debug") {
-    console_->set_level(spdlog::level::debug);
-  } else if (_console_level == "info") {
-    console_->set_level(spdlog::level::info);
-  } else if (_console_level == "warn") {
-    console_->set_level(spdlog::level::warn);
-  } else if (_console_level == "error") {
-    console_->set_level(spdlog::level::err);
-  } else if (_console_level == "critical") {
-    console_->set_level(spdlog::level::critical);
+  if (console_ != nullptr) {
+    if (_console_level == "off") {
+      console_->set_level(spdlog::level::off);
+    } else if (_console_level == "trace") {
+      console_->set_level(spdlog::level::trace);
+    } else if (_console_level == "debug") {
+      console_->set_level(spdlog::level::debug);
+    } else if (_console_level == "info") {
+      console_->set_level(spdlog::level::info);
+    } else if (_console_level == "warn") {
+      console_->set_level(spdlog::level::warn);
+    } else if (_console_level == "error") {
+      console_->set_level(spdlog::level::err);
+    } else if (_console_level == "critical") {
+      console_->set_level(spdlog::level::critical);
+    }
   }
   std::string pattern = "[%Y-%m-%d %H:%M:%S] [%^%L%$] %v";
   if (_utc) {
@@ -73,5 +127,99 @@ void EventLogger::Initialize(const std::string& _level,
   }
 }
 
+void EventLogger::OpenRecords(const std::string& _path) {
+  records_.open(_path, std::ios::out | std::ios::trunc | std::ios::binary);
+}
+
+void EventLogger::TransferStart(const SimulationClock& _clock,
+                                const uint16_t& _tx_index,
+                                const uint16_t& _rx_index) {
+  Write(kEvent::TransferStart, _clock, _tx_index, _rx_index, 0);
+  if (render_) {
+    log_->debug("[{}] N{}>N{} START", _clock, _tx_index, _rx_index);
+  }
+}
+
+void EventLogger::TransferEnd(const SimulationClock& _clock,
+                              const uint16_t& _tx_index,
+                              const uint16_t& _rx_index,
+                              const bool& _success) {
+  if (_success) {
+    Write(kEvent::TransferEnd, _clock, _tx_index, _rx_index, 0);
+    if (render_) {
+      log_->info("[{}] N{}>N{} OK", _clock, _tx_index, _rx_index);
+    }
+  } else {
+    Write(kEvent::TransferFail, _clock, _tx_index, _rx_index, 0);
+    if (render_) {
+      log_->warn("[{}] N{}>N{} FAIL", _clock, _tx_index, _rx_index);
+    }
+  }
+}
+
+void EventLogger::Prediction(const SimulationClock& _clock,
+                             const uint16_t& _source,
+                             const uint16_t& _destination,
+                             const uint64_t& _limit_s) {
+  Write(kEvent::Prediction, _clock, _source, _destination, _limit_s);
+  if (render_) {
+    log_->info("[{}] Predicting N{}>...>N{} within {} s",
+               _clock,
+               _source,
+               _destination,
+               _limit_s);
+  }
+}
+
+void EventLogger::Route(
+    const SimulationClock& _clock,
+    const uint16_t& _source,
+    const std::vector<std::pair<uint16_t, uint64_t>>& _route) {
+  uint16_t destination = _source;
+  if (!_route.empty()) {
+    destination = _route.back().first;
+  }
+  Write(kEvent::Route, _clock, _source, destination, _route.size());
+  for (uint64_t i = 0; i < _route.size(); ++i) {
+    Write(kEvent::RouteHop, _clock, _route[i].first, i, _route[i].second);
+  }
+  // Only build the text when it would be logged
+  if (render_ && log_->should_log(spdlog::level::info)) {
+    std::stringstream stream;
+    stream << "N" << _source;
+    for (auto &transfer : _route) {
+      stream << ">N" << transfer.first;
+    }
+    log_->info("[{}] Route found: {}", _clock, stream.str());
+  }
+}
+
+void EventLogger::MeasurementStart(const SimulationClock& _clock,
+                                   const uint16_t& _node,
+                                   const uint16_t& _return_index,
+                                   const std::string& _variable) {
+  Write(kEvent::MeasurementStart, _clock, _node, _return_index, 0);
+  if (render_) {
+    log_->info("[{}] N{} sensing \"{}\"", _clock, _node, _variable);
+  }
+}
+
+void EventLogger::Write(const kEvent& _type,
+                        const SimulationClock& _clock,
+                        const uint16_t& _node,
+                        const uint16_t& _peer,
+                        const uint64_t& _value) {
+  if (!records_.is_open()) {
+    return;
+  }
+  EventRecord record = {_clock.elapsed_s(),
+                        _value,
+                        _node,
+                        _peer,
+                        static_cast<uint8_t>(_type),
+                        {0, 0, 0}};
+  records_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
 }  // namespace collaborate
 }  // namespace osse
@@ -45,15 +45,7 @@ Geodetic::Geodetic(const double& _latitude_rad,
 Geodetic::Geodetic(const Vector& _position_m_rad,
                    const SimulationClock& _simulation_clock,
                    const uint64_t& _offset_s)
-    : latitude_rad_(CalculateLatitudeRad(_position_m_rad,
-                                         _simulation_clock,
-                                         _offset_s)),
-      longitude_rad_(CalculateLongitudeRad(_position_m_rad,
-                                           _simulation_clock,
-                                           _offset_s)),
-      altitude_m_(CalculateAltitudeM(_position_m_rad,
-                                     _simulation_clock,
-                                     _offset_s)) {
+    : Geodetic(Convert(_position_m_rad, _simulation_clock, _offset_s)) {
 }
 
 Geodetic::Geodetic(const std::array<double, 3>& _triple)
@@ -94,40 +86,19 @@ std::vector<double> Geodetic::ObtainLog() const {
   return {latitude_rad_, longitude_rad_, altitude_m_};
 }
 
-double Geodetic::CalculateLatitudeRad(const Vector& _position_m_rad,
-                                      const SimulationClock& _simulation_clock,
-                                      const uint64_t& _offset_s) const {
-  sgp4::Vector sgp4_pos(_position_m_rad.x_m() / 1000.0,
-                        _position_m_rad.y_m() / 1000.0,
-                        _position_m_rad.z_m() / 1000.0);
-  sgp4::Eci sgp4_eci(_simulation_clock.date_time().AddSeconds(_offset_s),
-                     sgp4_pos);
-  sgp4::CoordGeodetic sgp4_geodetic = sgp4_eci.ToGeodetic();
-  return sgp4_geodetic.latitude;
-}
-
-double Geodetic::CalculateLongitudeRad(const Vector& _position_m_rad,
-                                       const SimulationClock& _simulation_clock,
-                                       const uint64_t& _offset_s) const {
-  sgp4::Vector sgp4_pos(_position_m_rad.x_m() / 1000.0,
-                        _position_m_rad.y_m() / 1000.0,
-                        _position_m_rad.z_m() / 1000.0);
-  sgp4::Eci sgp4_eci(_simulation_clock.date_time().AddSeconds(_offset_s),
-                     sgp4_pos);
-  sgp4::CoordGeodetic sgp4_geodetic = sgp4_eci.ToGeodetic();
-  return sgp4_geodetic.longitude;
-}
-
-double Geodetic::CalculateAltitudeM(const Vector& _position_m_rad,
-                                    const SimulationClock& _simulation_clock,
-                                    const uint64_t& _offset_s) const {
+std::array<double, 3> Geodetic::Convert(
+    const Vector& _position_m_rad,
+    const SimulationClock& _simulation_clock,
+    const uint64_t& _offset_s) {
   sgp4::Vector sgp4_pos(_position_m_rad.x_m() / 1000.0,
                         _position_m_rad.y_m() / 1000.0,
                         _position_m_rad.z_m() / 1000.0);
   sgp4::Eci sgp4_eci(_simulation_clock.date_time().AddSeconds(_offset_s),
                      sgp4_pos);
   sgp4::CoordGeodetic sgp4_geodetic = sgp4_eci.ToGeodetic();
-  return sgp4_geodetic.altitude;
+  return {sgp4_geodetic.latitude,
+          sgp4_geodetic.longitude,
+          sgp4_geodetic.altitude};
 }
 
 std::array<double, 3> Geodetic::Intersection(
@@ -186,8 +157,7 @@ std::array<double, 3> Geodetic::Intersection(
       intersection_ = intersection_2;
     }
   }
-  Geodetic local(intersection_, _simulation_clock, _offset_s);
-  return {local.latitude_rad(), local.longitude_rad(), local.altitude_m()};
+  return Convert(intersection_, _simulation_clock, _offset_s);
 }
 
 std::string Geodetic::ToString() const {
@@ -19,7 +19,7 @@
 namespace osse {
 namespace collaborate {
 
-Graph::Graph(DataLogger* _data_log) : data_log_(_data_log) {
+Graph::Graph(DataLogger* _data_log) : data_log_(_data_log), num_nodes_(0) {
 }
 
 }  // namespace collaborate
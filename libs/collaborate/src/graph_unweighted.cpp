@@ -15,17 +15,19 @@
 
 #include "collaborate/graph_unweighted.h"
 
-#include <array>
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
-#include <fstream>
 #include <limits>
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "collaborate/data_logger.h"
 #include "collaborate/graph.h"
 #include "collaborate/graph_weighted.h"
+#include "collaborate/indexed_heap.h"
 #include "collaborate/util.h"
 #include "collaborate/vector.h"
 
@@ -34,47 +36,268 @@ namespace collaborate {
 
 GraphUnweighted::GraphUnweighted(DataLogger* _data_log)
     : Graph(_data_log),
-      edges_(new Edges{false}) {
+      edges_(std::vector<uint64_t>()),
+      words_per_row_(0),
+      events_(false),
+      snapshot_ticks_(0),
+      logged_(std::vector<uint64_t>()),
+      num_events_(0),
+      num_snapshots_(0),
+      event_time_(std::vector<uint64_t>()),
+      event_rx_(std::vector<uint16_t>()),
+      event_tx_(std::vector<uint16_t>()),
+      event_on_(std::vector<int8_t>()) {
+}
+
+GraphUnweighted::GraphUnweighted(DataLogger* _data_log,
+                                 const uint64_t& _snapshot_ticks)
+    : Graph(_data_log),
+      edges_(std::vector<uint64_t>()),
+      words_per_row_(0),
+      events_(true),
+      snapshot_ticks_(_snapshot_ticks),
+      logged_(std::vector<uint64_t>()),
+      num_events_(0),
+      num_snapshots_(0),
+      event_time_(std::vector<uint64_t>()),
+      event_rx_(std::vector<uint16_t>()),
+      event_tx_(std::vector<uint16_t>()),
+      event_on_(std::vector<int8_t>()) {
 }
 
 void GraphUnweighted::Log(const uint16_t& _num_nodes,
-                          const uint64_t& _tick) const {
-  bool edges[Graph::kSize];
-  uint16_t index_1d = 0;
+                          const uint64_t& _tick) {
+  if (events_) {
+    LogEvents(_num_nodes, _tick);
+    return;
+  }
+  std::unique_ptr<bool[]> edges(new bool[_num_nodes * _num_nodes]);
+  Dense(_num_nodes, edges.get());
+  data_log_->LogUnweightedGraph(_tick, edges.get(), _num_nodes);
+}
+
+void GraphUnweighted::LogEvents(const uint16_t& _num_nodes,
+                                const uint64_t& _tick) {
+  uint16_t rows = std::min(_num_nodes, num_nodes_);
+  for (uint16_t r = 0; r < rows; ++r) {
+    for (uint64_t w = 0; w < words_per_row_; ++w) {
+      uint64_t index = util::Index(r, w, words_per_row_);
+      uint64_t changed = edges_[index] ^ logged_[index];
+      while (changed != 0) {
+        uint64_t bit = __builtin_ctzll(changed);
+        uint64_t col = w * kWordBits + bit;
+        changed &= changed - 1;
+        if (col >= _num_nodes) {
+          break;
+        }
+        logged_[index] ^= uint64_t(1) << bit;
+        event_time_.push_back(_tick);
+        event_rx_.push_back(r);
+        event_tx_.push_back(col);
+        event_on_.push_back((edges_[index] >> bit) & 1);
+      }
+    }
+  }
+  uint64_t count = event_time_.size();
+  if (count > 0) {
+    data_log_->LogSeries("event_time", event_time_.data(), num_events_, count);
+    data_log_->LogSeries("event_rx", event_rx_.data(), num_events_, count);
+    data_log_->LogSeries("event_tx", event_tx_.data(), num_events_, count);
+    data_log_->LogSeries("event_on", event_on_.data(), num_events_, count);
+    num_events_ += count;
+    event_time_.clear();
+    event_rx_.clear();
+    event_tx_.clear();
+    event_on_.clear();
+  }
+  if ((snapshot_ticks_ > 0) && (_tick % snapshot_ticks_ == 0)) {
+    std::unique_ptr<bool[]> edges(new bool[_num_nodes * _num_nodes]);
+    Dense(_num_nodes, edges.get());
+    data_log_->LogUnweightedSnapshot(num_snapshots_,
+                                     _tick,
+                                     num_events_,
+                                     edges.get(),
+                                     _num_nodes);
+    ++num_snapshots_;
+  }
+}
+
+void GraphUnweighted::Dense(const uint16_t& _num_nodes, bool* _edges) const {
+  uint64_t index_1d = 0;
   for (uint16_t r = 0; r < _num_nodes; ++r) {
     for (uint16_t c = 0; c < _num_nodes; ++c) {
-      uint64_t index_2d = util::Index(r, c, Graph::kMaxNodes);
-      edges[index_1d] = (*edges_)[index_2d];
+      _edges[index_1d] = GetEdge(r, c);
       ++index_1d;
     }
   }
-  data_log_->LogUnweightedGraph(_tick, edges, _num_nodes);
 }
 
 void GraphUnweighted::SetEdge(const uint16_t& _row,
                               const uint16_t& _col,
                               const bool& _value) {
-  (*edges_)[util::Index(_row, _col, Graph::kMaxNodes)] = _value;
+  if ((_row >= num_nodes_) || (_col >= num_nodes_)) {
+    if (!_value) {
+      return;
+    }
+    Resize(std::max(_row, _col) + 1);
+  }
+  uint64_t word = util::Index(_row, _col / kWordBits, words_per_row_);
+  uint64_t mask = uint64_t(1) << (_col % kWordBits);
+  if (_value) {
+    edges_[word] |= mask;
+  } else {
+    edges_[word] &= ~mask;
+  }
 }
 
 bool GraphUnweighted::GetEdge(const uint16_t& _row,
                               const uint16_t& _col) const {
-  return (*edges_)[util::Index(_row, _col, Graph::kMaxNodes)];
+  if ((_row >= num_nodes_) || (_col >= num_nodes_)) {
+    return false;
+  }
+  uint64_t word = util::Index(_row, _col / kWordBits, words_per_row_);
+  return (edges_[word] >> (_col % kWordBits)) & 1;
 }
 
 std::set<uint16_t> GraphUnweighted::GetRow(const uint16_t& _row,
                                            const uint16_t& _num_nodes) const {
   std::set<uint16_t> row;
-  for (uint16_t col = 0; col < _num_nodes; ++col) {
-    if (GetEdge(_row, col)) {
-      row.insert(col);
+  for (auto col : Neighbors(_row)) {
+    if (col < _num_nodes) {
+      row.insert(row.end(), col);
     }
   }
   return row;
 }
 
+std::vector<uint16_t> GraphUnweighted::Neighbors(const uint16_t& _row) const {
+  std::vector<uint16_t> neighbors;
+  if (_row >= num_nodes_) {
+    return neighbors;
+  }
+  neighbors.reserve(Degree(_row));
+  const uint64_t* words = &edges_[util::Index(_row, 0, words_per_row_)];
+  for (uint64_t w = 0; w < words_per_row_; ++w) {
+    uint64_t word = words[w];
+    while (word != 0) {
+      neighbors.push_back(w * kWordBits + __builtin_ctzll(word));
+      // Clear the lowest set bit
+      word &= word - 1;
+    }
+  }
+  return neighbors;
+}
+
+uint16_t GraphUnweighted::Degree(const uint16_t& _row) const {
+  if (_row >= num_nodes_) {
+    return 0;
+  }
+  const uint64_t* words = &edges_[util::Index(_row, 0, words_per_row_)];
+  uint16_t degree = 0;
+  for (uint64_t w = 0; w < words_per_row_; ++w) {
+    degree += __builtin_popcountll(words[w]);
+  }
+  return degree;
+}
+
+uint16_t GraphUnweighted::CommonNeighbors(const uint16_t& _row_a,
+                                          const uint16_t& _row_b) const {
+  if ((_row_a >= num_nodes_) || (_row_b >= num_nodes_)) {
+    return 0;
+  }
+  const uint64_t* a = &edges_[util::Index(_row_a, 0, words_per_row_)];
+  const uint64_t* b = &edges_[util::Index(_row_b, 0, words_per_row_)];
+  uint16_t common = 0;
+  for (uint64_t w = 0; w < words_per_row_; ++w) {
+    common += __builtin_popcountll(a[w] & b[w]);
+  }
+  return common;
+}
+
+std::vector<uint64_t> GraphUnweighted::Reach(const uint16_t& _row,
+                                             const uint16_t& _hops) const {
+  std::vector<uint64_t> reached(words_per_row_, 0);
+  if (_row >= num_nodes_) {
+    return reached;
+  }
+  reached[_row / kWordBits] |= uint64_t(1) << (_row % kWordBits);
+  std::vector<uint64_t> frontier = reached;
+  for (uint16_t hop = 0; hop < _hops; ++hop) {
+    // OR the rows of the frontier, keeping only newly reached nodes
+    std::vector<uint64_t> next(words_per_row_, 0);
+    for (uint64_t w = 0; w < words_per_row_; ++w) {
+      uint64_t word = frontier[w];
+      while (word != 0) {
+        uint64_t node = w * kWordBits + __builtin_ctzll(word);
+        const uint64_t* row = &edges_[util::Index(node, 0, words_per_row_)];
+        for (uint64_t v = 0; v < words_per_row_; ++v) {
+          next[v] |= row[v];
+        }
+        word &= word - 1;
+      }
+    }
+    bool grown = false;
+    for (uint64_t w = 0; w < words_per_row_; ++w) {
+      next[w] &= ~reached[w];
+      reached[w] |= next[w];
+      grown = grown || (next[w] != 0);
+    }
+    if (!grown) {
+      break;
+    }
+    frontier.swap(next);
+  }
+  return reached;
+}
+
+bool GraphUnweighted::Connected() const {
+  if (num_nodes_ == 0) {
+    return true;
+  }
+  std::vector<uint64_t> reached = Reach(0, num_nodes_);
+  uint16_t count = 0;
+  for (auto word : reached) {
+    count += __builtin_popcountll(word);
+  }
+  return count == num_nodes_;
+}
+
 void GraphUnweighted::Clear() {
-  (*edges_).fill(false);
+  std::fill(edges_.begin(), edges_.end(), 0);
+}
+
+void GraphUnweighted::Resize(const uint16_t& _num_nodes) {
+  if (_num_nodes == num_nodes_) {
+    return;
+  }
+  uint64_t words_per_row = (_num_nodes + kWordBits - 1) / kWordBits;
+  edges_ = Repack(edges_, _num_nodes, words_per_row);
+  if (events_) {
+    logged_ = Repack(logged_, _num_nodes, words_per_row);
+  }
+  words_per_row_ = words_per_row;
+  num_nodes_ = _num_nodes;
+}
+
+std::vector<uint64_t> GraphUnweighted::Repack(
+    const std::vector<uint64_t>& _bits,
+    const uint16_t& _num_nodes,
+    const uint64_t& _words_per_row) const {
+  std::vector<uint64_t> bits(_num_nodes * _words_per_row, 0);
+  uint16_t rows = std::min(_num_nodes, num_nodes_);
+  uint64_t words = std::min(_words_per_row, words_per_row_);
+  for (uint16_t r = 0; r < rows; ++r) {
+    for (uint64_t w = 0; w < words; ++w) {
+      bits[util::Index(r, w, _words_per_row)] =
+          _bits[util::Index(r, w, words_per_row_)];
+    }
+    // Drop columns past the new size that share the last word
+    if ((_num_nodes < num_nodes_) && (_num_nodes % kWordBits != 0)) {
+      uint64_t mask = (uint64_t(1) << (_num_nodes % kWordBits)) - 1;
+      bits[util::Index(r, _words_per_row - 1, _words_per_row)] &= mask;
+    }
+  }
+  return bits;
 }
 
 void GraphUnweighted::TransferRoute(const std::vector<uint16_t>& _route) {
@@ -108,36 +331,38 @@ void GraphUnweighted::MaskWeighted(const uint16_t& _num_nodes,
 
 bool GraphUnweighted::Prim(const GraphWeighted& _weighted,
                            const uint16_t& _num_nodes) {
-  int start = 0;
-  std::array<double, Graph::kMaxNodes> dist{};
-  dist.fill(std::numeric_limits<double>::max());
+  if (_num_nodes == 0) {
+    return true;
+  }
+  uint16_t start = 0;
+  std::vector<double> dist(_num_nodes, std::numeric_limits<double>::max());
   dist[start] = 0;
-  std::array<bool, Graph::kMaxNodes> unseen;
-  unseen.fill(false);
-  std::array<int, Graph::kMaxNodes> parent{};
-  parent[start] = -1;
-  bool connected_ = true;
-  for (uint16_t count = 0; count < _num_nodes - 1; ++count) {
-    int min_index = -1;
-    double min_value = std::numeric_limits<double>::max();
-    for (uint16_t node = 0; node < _num_nodes; ++node) {
-      if (unseen[node] == false && dist[node] < min_value) {
-        min_value = dist[node], min_index = node;
-      }
+  std::vector<bool> seen(_num_nodes, false);
+  std::vector<uint16_t> parent(_num_nodes, start);
+  IndexedHeap heap(_num_nodes);
+  heap.Push(start, 0);
+  uint16_t count = 0;
+  while (!heap.Empty()) {
+    uint16_t min_index = heap.Pop();
+    seen[min_index] = true;
+    ++count;
+    if (min_index >= _weighted.num_nodes()) {
+      continue;
     }
-    if (min_index != -1) {
-      unseen[min_index] = true;
-      for (uint16_t node = 0; node < _num_nodes; ++node) {
-        double weight = _weighted.GetEdge(node, min_index);
-        if ((weight > 0) && !unseen[node] && (weight < dist[node])) {
-          parent[node] = min_index;
-          dist[node] = weight;
-        }
+    for (auto &edge : _weighted.GetRow(min_index)) {
+      uint16_t node = edge.first;
+      double weight = edge.second;
+      if ((node < _num_nodes)
+          && (weight > 0)
+          && !seen[node]
+          && (weight < dist[node])) {
+        parent[node] = min_index;
+        dist[node] = weight;
+        heap.Push(node, weight);
       }
-    } else {
-      connected_ = false;
     }
   }
+  bool connected_ = (count == _num_nodes);
   if (connected_) {
     for (uint16_t i = 1; i < _num_nodes; ++i) {
       SetEdge(i, parent[i], true);
@@ -15,17 +15,17 @@
 
 #include "collaborate/graph_weighted.h"
 
-#include <array>
+#include <algorithm>
 #include <cstdint>
-#include <fstream>
 #include <limits>
-#include <queue>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "collaborate/data_logger.h"
 #include "collaborate/graph.h"
+#include "collaborate/indexed_heap.h"
 #include "collaborate/util.h"
 
 namespace osse {
@@ -33,76 +33,95 @@ namespace collaborate {
 
 GraphWeighted::GraphWeighted(DataLogger* _data_log)
     : Graph(_data_log),
-      edges_(new Edges{0}) {
+      edges_(std::vector<Row>()) {
 }
 
 void GraphWeighted::Clear() {
-  (*edges_).fill(0.0);
+  for (auto &row : edges_) {
+    row.clear();
+  }
+}
+
+void GraphWeighted::Resize(const uint16_t& _num_nodes) {
+  edges_.resize(_num_nodes);
+  if (_num_nodes < num_nodes_) {
+    for (auto &row : edges_) {
+      uint64_t kept = 0;
+      for (uint64_t i = 0; i < row.size(); ++i) {
+        if (row[i].first < _num_nodes) {
+          row[kept] = row[i];
+          ++kept;
+        }
+      }
+      row.resize(kept);
+    }
+  }
+  num_nodes_ = _num_nodes;
 }
 
 void GraphWeighted::Log(const uint16_t& _num_nodes,
-                        const uint64_t& _tick) const {
-  double edges[Graph::kSize];
-  uint16_t index_1d = 0;
-  for (uint16_t r = 0; r < _num_nodes; ++r) {
-    for (uint16_t c = 0; c < _num_nodes; ++c) {
-      uint64_t index_2d = util::Index(r, c, Graph::kMaxNodes);
-      edges[index_1d] = (*edges_)[index_2d];
-      ++index_1d;
+                        const uint64_t& _tick) {
+  std::vector<double> edges(_num_nodes * _num_nodes, 0.0);
+  uint16_t rows = std::min(_num_nodes, num_nodes_);
+  for (uint16_t r = 0; r < rows; ++r) {
+    for (auto &edge : edges_[r]) {
+      if (edge.first < _num_nodes) {
+        edges[util::Index(r, edge.first, _num_nodes)] = edge.second;
+      }
     }
   }
-  data_log_->LogWeightedGraph(_tick, edges, _num_nodes);
+  data_log_->LogWeightedGraph(_tick, edges.data(), _num_nodes);
 }
 
 void GraphWeighted::SetEdge(const uint16_t& _row,
                             const uint16_t& _col,
                             const double& _value) {
-  (*edges_)[util::Index(_row, _col, Graph::kMaxNodes)] = _value;
+  if ((_row >= num_nodes_) || (_col >= num_nodes_)) {
+    if (_value == 0) {
+      return;
+    }
+    Resize(std::max(_row, _col) + 1);
+  }
+  Row& row = edges_[_row];
+  for (auto edge = row.begin(); edge != row.end(); ++edge) {
+    if (edge->first == _col) {
+      if (_value == 0) {
+        *edge = row.back();
+        row.pop_back();
+      } else {
+        edge->second = _value;
+      }
+      return;
+    }
+  }
+  if (_value != 0) {
+    row.push_back(std::pair<uint16_t, double>(_col, _value));
+  }
 }
 
 double GraphWeighted::GetEdge(const uint16_t& _row,
                               const uint16_t& _col) const {
-  return (*edges_)[util::Index(_row, _col, Graph::kMaxNodes)];
+  if (_row >= num_nodes_) {
+    return 0.0;
+  }
+  for (auto &edge : edges_[_row]) {
+    if (edge.first == _col) {
+      return edge.second;
+    }
+  }
+  return 0.0;
 }
 
 std::vector<uint16_t> GraphWeighted::Dijkstra(const uint16_t& start,
                                               const uint16_t& end) {
-  // Setup
-  std::array<double, Graph::kMaxNodes> dist;
-  dist.fill(std::numeric_limits<double>::max());
-  dist[start] = 0;
-  std::array<uint16_t, Graph::kMaxNodes> parent{};
-  std::priority_queue<std::pair<double, uint16_t>,
-                      std::vector<std::pair<double, uint16_t> >,
-                      std::greater<std::pair<double, uint16_t> > > Q;
-  Q.push(std::pair<double, uint16_t>(0, start));
-  bool found = false;
-  while (!Q.empty()) {
-    uint16_t cur_node = Q.top().second;
-    double cost_so_far = Q.top().first;
-    Q.pop();
-
-    // Skip computation if distance is greater than shortest so far
-    if (dist[cur_node] < cost_so_far) continue;
-
-    // Iterate adjacent nodes
-    for (uint16_t i = 0; i < Graph::kMaxNodes; ++i) {
-      double weight = GetEdge(cur_node, i);
-      if (weight > 0) {
-        uint16_t adj_node = i;
-
-        // Check for an improvement in path distance
-        if (dist[adj_node] > dist[cur_node] + weight) {
-          dist[adj_node] = dist[cur_node] + weight;
-          Q.push(std::pair<double, uint16_t>(dist[adj_node], adj_node));
-          parent[adj_node] = cur_node;
-          if (adj_node == end) {
-            found = true;
-          }
-        }
-      }
-    }
+  std::vector<double> dist;
+  std::vector<uint16_t> parent;
+  if ((start >= num_nodes_) || (end >= num_nodes_)) {
+    return std::vector<uint16_t>(1, end);
   }
+  ShortestPaths(start, end, &dist, &parent);
+  bool found = (start != end)
+               && (dist[end] < std::numeric_limits<double>::max());
 
   // Construct path
   uint16_t path_index = end;
@@ -117,5 +136,96 @@ std::vector<uint16_t> GraphWeighted::Dijkstra(const uint16_t& start,
   return path_;
 }
 
+std::vector<double> GraphWeighted::Distances(const uint16_t& _start) const {
+  std::vector<double> dist;
+  std::vector<uint16_t> parent;
+  if (_start >= num_nodes_) {
+    return std::vector<double>(num_nodes_, std::numeric_limits<double>::max());
+  }
+  ShortestPaths(_start, std::numeric_limits<uint16_t>::max(), &dist, &parent);
+  return dist;
+}
+
+std::vector<double> GraphWeighted::AllPairs(
+    const uint16_t& _num_threads) const {
+  std::vector<double> lengths(num_nodes_ * num_nodes_, 0.0);
+  uint16_t num_threads = _num_threads;
+  if (num_threads == 0) {
+    num_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  num_threads = std::min(num_threads, num_nodes_);
+  if (num_threads <= 1) {
+    AllPairsRows(0, num_nodes_, &lengths);
+    return lengths;
+  }
+  // Each thread writes a disjoint block of rows
+  std::vector<std::thread> threads;
+  uint16_t per_thread = (num_nodes_ + num_threads - 1) / num_threads;
+  for (uint16_t first = 0; first < num_nodes_; first += per_thread) {
+    uint16_t last = std::min<uint16_t>(first + per_thread, num_nodes_);
+    threads.push_back(std::thread(&GraphWeighted::AllPairsRows,
+                                  this,
+                                  first,
+                                  last,
+                                  &lengths));
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return lengths;
+}
+
+void GraphWeighted::ShortestPaths(const uint16_t& _start,
+                                  const uint16_t& _end,
+                                  std::vector<double>* _dist,
+                                  std::vector<uint16_t>* _parent) const {
+  // Setup
+  std::vector<double>& dist = *_dist;
+  std::vector<uint16_t>& parent = *_parent;
+  dist.assign(num_nodes_, std::numeric_limits<double>::max());
+  parent.assign(num_nodes_, _start);
+  std::vector<bool> settled(num_nodes_, false);
+  dist[_start] = 0;
+  IndexedHeap heap(num_nodes_);
+  heap.Push(_start, 0);
+  while (!heap.Empty()) {
+    uint16_t cur_node = heap.Pop();
+    settled[cur_node] = true;
+    if (cur_node == _end) {
+      break;
+    }
+
+    // Iterate adjacent nodes
+    for (auto &edge : edges_[cur_node]) {
+      double weight = edge.second;
+      uint16_t adj_node = edge.first;
+
+      // Check for an improvement in path distance
+      if ((weight > 0)
+          && !settled[adj_node]
+          && (dist[adj_node] > dist[cur_node] + weight)) {
+        dist[adj_node] = dist[cur_node] + weight;
+        parent[adj_node] = cur_node;
+        heap.Push(adj_node, dist[adj_node]);
+      }
+    }
+  }
+}
+
+void GraphWeighted::AllPairsRows(const uint16_t& _first,
+                                 const uint16_t& _last,
+                                 std::vector<double>* _lengths) const {
+  std::vector<double> dist;
+  std::vector<uint16_t> parent;
+  for (uint16_t r = _first; r < _last; ++r) {
+    ShortestPaths(r, std::numeric_limits<uint16_t>::max(), &dist, &parent);
+    for (uint16_t c = 0; c < num_nodes_; ++c) {
+      if (dist[c] < std::numeric_limits<double>::max()) {
+        (*_lengths)[util::Index(r, c, num_nodes_)] = dist[c];
+      }
+    }
+  }
+}
+
 }  // namespace collaborate
 }  // namespace osse
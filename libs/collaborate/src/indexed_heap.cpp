@@ -0,0 +1,101 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "collaborate/indexed_heap.h"
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace osse {
+namespace collaborate {
+
+constexpr uint64_t IndexedHeap::kAbsent;
+
+IndexedHeap::IndexedHeap(const uint16_t& _num_nodes)
+    : heap_(std::vector<std::pair<double, uint16_t>>()),
+      position_(std::vector<uint64_t>(_num_nodes, kAbsent)) {
+  heap_.reserve(_num_nodes);
+}
+
+bool IndexedHeap::Contains(const uint16_t& _node) const {
+  return position_[_node] != kAbsent;
+}
+
+void IndexedHeap::Push(const uint16_t& _node, const double& _priority) {
+  if (Contains(_node)) {
+    uint64_t position = position_[_node];
+    if (_priority < heap_[position].first) {
+      heap_[position].first = _priority;
+      SiftUp(position);
+    }
+  } else {
+    heap_.push_back(std::pair<double, uint16_t>(_priority, _node));
+    position_[_node] = heap_.size() - 1;
+    SiftUp(heap_.size() - 1);
+  }
+}
+
+uint16_t IndexedHeap::Pop() {
+  uint16_t node = heap_.front().second;
+  Swap(0, heap_.size() - 1);
+  heap_.pop_back();
+  position_[node] = kAbsent;
+  if (!heap_.empty()) {
+    SiftDown(0);
+  }
+  return node;
+}
+
+void IndexedHeap::SiftUp(uint64_t _position) {
+  while (_position > 0) {
+    uint64_t parent = (_position - 1) / 2;
+    if (heap_[parent].first <= heap_[_position].first) {
+      break;
+    }
+    Swap(parent, _position);
+    _position = parent;
+  }
+}
+
+void IndexedHeap::SiftDown(uint64_t _position) {
+  uint64_t size = heap_.size();
+  while (true) {
+    uint64_t smallest = _position;
+    uint64_t left = 2 * _position + 1;
+    uint64_t right = left + 1;
+    if ((left < size) && (heap_[left].first < heap_[smallest].first)) {
+      smallest = left;
+    }
+    if ((right < size) && (heap_[right].first < heap_[smallest].first)) {
+      smallest = right;
+    }
+    if (smallest == _position) {
+      break;
+    }
+    Swap(smallest, _position);
+    _position = smallest;
+  }
+}
+
+void IndexedHeap::Swap(const uint64_t& _a, const uint64_t& _b) {
+  std::swap(heap_[_a], heap_[_b]);
+  position_[heap_[_a].second] = _a;
+  position_[heap_[_b].second] = _b;
+}
+
+}  // namespace collaborate
+}  // namespace osse
@@ -0,0 +1,159 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "collaborate/measurement_logger.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "collaborate/data_logger.h"
+
+namespace osse {
+namespace collaborate {
+
+MeasurementLogger::MeasurementLogger(const std::string& _path)
+    : data_log_(_path),
+      buffer_({}),
+      row_size_(std::vector<uint64_t>()),
+      complete_s_(std::vector<uint64_t>()),
+      node_(std::vector<uint16_t>()),
+      num_samples_(0),
+      num_measurements_(0) {
+  data_log_.RaggedMeasurement();
+}
+
+MeasurementLogger::~MeasurementLogger() {
+  Flush();
+}
+
+void MeasurementLogger::Append(const LogBuffer& _samples,
+                               const uint64_t& _elapsed_s,
+                               const uint16_t& _node_index) {
+  buffer_.elapsed_s.insert(buffer_.elapsed_s.end(),
+                           _samples.elapsed_s.begin(),
+                           _samples.elapsed_s.end());
+  buffer_.year.insert(buffer_.year.end(),
+                      _samples.year.begin(),
+                      _samples.year.end());
+  buffer_.month.insert(buffer_.month.end(),
+                       _samples.month.begin(),
+                       _samples.month.end());
+  buffer_.day.insert(buffer_.day.end(),
+                     _samples.day.begin(),
+                     _samples.day.end());
+  buffer_.hour.insert(buffer_.hour.end(),
+                      _samples.hour.begin(),
+                      _samples.hour.end());
+  buffer_.minute.insert(buffer_.minute.end(),
+                        _samples.minute.begin(),
+                        _samples.minute.end());
+  buffer_.second.insert(buffer_.second.end(),
+                        _samples.second.begin(),
+                        _samples.second.end());
+  buffer_.microsecond.insert(buffer_.microsecond.end(),
+                             _samples.microsecond.begin(),
+                             _samples.microsecond.end());
+  buffer_.latitude_rad.insert(buffer_.latitude_rad.end(),
+                              _samples.latitude_rad.begin(),
+                              _samples.latitude_rad.end());
+  buffer_.longitude_rad.insert(buffer_.longitude_rad.end(),
+                               _samples.longitude_rad.begin(),
+                               _samples.longitude_rad.end());
+  buffer_.altitude_m.insert(buffer_.altitude_m.end(),
+                            _samples.altitude_m.begin(),
+                            _samples.altitude_m.end());
+  buffer_.measurement.insert(buffer_.measurement.end(),
+                             _samples.measurement.begin(),
+                             _samples.measurement.end());
+  buffer_.resolution_m.insert(buffer_.resolution_m.end(),
+                              _samples.resolution_m.begin(),
+                              _samples.resolution_m.end());
+  buffer_.index.insert(buffer_.index.end(),
+                       _samples.index.begin(),
+                       _samples.index.end());
+  row_size_.push_back(_samples.elapsed_s.size());
+  complete_s_.push_back(_elapsed_s);
+  node_.push_back(_node_index);
+  if (buffer_.elapsed_s.size() >= kFlushSamples) {
+    Flush();
+  }
+}
+
+void MeasurementLogger::Flush() {
+  uint64_t count = buffer_.elapsed_s.size();
+  uint64_t instances = row_size_.size();
+  if (instances == 0) {
+    return;
+  }
+  uint64_t index = num_samples_;
+  data_log_.LogSeries("time", buffer_.elapsed_s.data(), index, count);
+  data_log_.LogSeries("year", buffer_.year.data(), index, count);
+  data_log_.LogSeries("month", buffer_.month.data(), index, count);
+  data_log_.LogSeries("day", buffer_.day.data(), index, count);
+  data_log_.LogSeries("hour", buffer_.hour.data(), index, count);
+  data_log_.LogSeries("minute", buffer_.minute.data(), index, count);
+  data_log_.LogSeries("second", buffer_.second.data(), index, count);
+  data_log_.LogSeries("microsecond",
+                      buffer_.microsecond.data(),
+                      index,
+                      count);
+  data_log_.LogSeries("latitude", buffer_.latitude_rad.data(), index, count);
+  data_log_.LogSeries("longitude",
+                      buffer_.longitude_rad.data(),
+                      index,
+                      count);
+  data_log_.LogSeries("altitude", buffer_.altitude_m.data(), index, count);
+  data_log_.LogSeries("measurement",
+                      buffer_.measurement.data(),
+                      index,
+                      count);
+  data_log_.LogSeries("resolution",
+                      buffer_.resolution_m.data(),
+                      index,
+                      count);
+  data_log_.LogSeries("index", buffer_.index.data(), index, count);
+  data_log_.LogSeries("row_size",
+                      row_size_.data(),
+                      num_measurements_,
+                      instances);
+  data_log_.LogSeries("complete",
+                      complete_s_.data(),
+                      num_measurements_,
+                      instances);
+  data_log_.LogSeries("node", node_.data(), num_measurements_, instances);
+  num_samples_ += count;
+  num_measurements_ += instances;
+  buffer_.elapsed_s.clear();
+  buffer_.year.clear();
+  buffer_.month.clear();
+  buffer_.day.clear();
+  buffer_.hour.clear();
+  buffer_.minute.clear();
+  buffer_.second.clear();
+  buffer_.microsecond.clear();
+  buffer_.latitude_rad.clear();
+  buffer_.longitude_rad.clear();
+  buffer_.altitude_m.clear();
+  buffer_.measurement.clear();
+  buffer_.resolution_m.clear();
+  buffer_.index.clear();
+  row_size_.clear();
+  complete_s_.clear();
+  node_.clear();
+}
+
+}  // namespace collaborate
+}  // namespace osse
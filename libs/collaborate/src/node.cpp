@@ -24,6 +24,7 @@
 #include "collaborate/data_logger.h"
 #include "collaborate/data_processor.h"
 #include "collaborate/event_logger.h"
+#include "collaborate/geodetic.h"
 #include "collaborate/packet_forward.h"
 #include "collaborate/packet_return.h"
 #include "collaborate/platform.h"
@@ -32,6 +33,7 @@
 #include "collaborate/subsystem_comm.h"
 #include "collaborate/subsystem_power.h"
 #include "collaborate/subsystem_sensing.h"
+#include "collaborate/vector.h"
 
 namespace osse {
 namespace collaborate {
@@ -111,23 +113,51 @@ void Node::UpdateSensingAntenna() {
                             orbital_state_.body_frame());
 }
 
+void Node::UpdateMeasurements(const SimulationClock& _clock,
+                              const std::vector<Node*>& _nodes) {
+  std::vector<SubsystemSensing*> sensing;
+  std::vector<Vector> positions_m_rad;
+  std::vector<int> indices;
+  sensing.reserve(_nodes.size());
+  positions_m_rad.reserve(_nodes.size());
+  indices.reserve(_nodes.size());
+  for (auto node : _nodes) {
+    node->StartMeasurement();
+    sensing.push_back(&node->sensing_if_);
+    positions_m_rad.push_back(node->orbital_state_.position_m_rad());
+    indices.push_back(node->index_);
+  }
+  SubsystemSensing::UpdateSwath(_clock, sensing, positions_m_rad, indices);
+  for (auto node : _nodes) {
+    node->CompleteMeasurement();
+  }
+}
+
 void Node::UpdateMeasurement() {
+  StartMeasurement();
+  sensing_if_.Update(*clock_, orbital_state_.position_m_rad(), index_);
+  CompleteMeasurement();
+}
+
+void Node::StartMeasurement() {
   for (auto plan = measurements_.begin(); plan != measurements_.end();) {
     if ((clock_->elapsed_s() > (*plan).first) && !sensing_if_.active()) {
       mode_ = kMode::Sensing;
       sensing_if_.Measure((*plan).second);
-      event_log_->log()->info("[{}] N{} sensing \"{}\"",
-                              *clock_,
-                              index_,
-                              sensing_if_.sensor()->kVariable());
+      event_log_->MeasurementStart(*clock_,
+                                   index_,
+                                   (*plan).second,
+                                   sensing_if_.sensor()->kVariable());
       measurements_.erase(plan);
     } else {
       ++plan;
     }
   }
-  sensing_if_.Update(*clock_, orbital_state_.position_m_rad(), index_);
+}
+
+void Node::CompleteMeasurement() {
   if (sensing_if_.complete()) {
-    kDataProcessor_->Compute(ReadRawBuffer(sensing_if_.data_buffer()),
+    kDataProcessor_->Compute(ViewRawBuffer(sensing_if_.data_buffer()),
                              index_,
                              *clock_,
                              &min_suggestions_,
@@ -170,10 +200,9 @@ void Node::PlanMeasurement(const uint64_t& _start_s,
 }
 
 void Node::AddressCommBuffer() {
-  std::vector<uint8_t> buffer = comm_if_.data_buffer();
-  if (buffer.size() == PacketForward::kPacketForwardSizeBytes) {
-    PacketForward packet(comm_if_.data_buffer());
-    comm_if_.EraseDataBuffer();
+  uint64_t size_bytes = comm_if_.data_buffer().size();
+  if (size_bytes == PacketForward::kPacketForwardSizeBytes) {
+    PacketForward packet(comm_if_.ReleaseDataBuffer());
     std::vector<std::pair<uint16_t, uint64_t>> route;
     route = packet.DecodePartialRoute();
     bool found_self = false;
@@ -187,19 +216,20 @@ void Node::AddressCommBuffer() {
       ++index;
     }
     if (!found_self) {
-      comm_if_.AddToStorage({route[0].first, route[0].second, packet});
+      comm_if_.AddToStorage({route[0].first,
+                             route[0].second,
+                             std::move(packet)});
     } else {
       if (self_index == route.size()-1) {
         PlanMeasurement(packet.event().second, packet.feedback());
       } else {
         comm_if_.AddToStorage({route[self_index+1].first,
                                route[self_index+1].second,
-                               packet});
+                               std::move(packet)});
       }
     }
-  } else if (buffer.size() == PacketReturn::kPacketReturnSizeBytes) {
-    PacketReturn packet(comm_if_.data_buffer());
-    comm_if_.EraseDataBuffer();
+  } else if (size_bytes == PacketReturn::kPacketReturnSizeBytes) {
+    PacketReturn packet(comm_if_.ReleaseDataBuffer());
     std::vector<std::pair<uint16_t, uint64_t>> route;
     route = packet.DecodePartialRoute();
     bool found_self = false;
@@ -213,7 +243,9 @@ void Node::AddressCommBuffer() {
       ++index;
     }
     if (!found_self) {
-      comm_if_.AddToStorage({route[0].first, route[0].second, packet});
+      comm_if_.AddToStorage({route[0].first,
+                             route[0].second,
+                             std::move(packet)});
     } else {
       if (self_index == route.size()-1) {
         kDataProcessor_->Regression(packet.success().first,
@@ -221,12 +253,16 @@ void Node::AddressCommBuffer() {
       } else {
         comm_if_.AddToStorage({route[self_index+1].first,
                                route[self_index+1].second,
-                               packet});
+                               std::move(packet)});
       }
     }
   }
 }
 
+void Node::MoveSensorDataToCommBuffer() {
+  comm_if_.set_data_buffer(sensing_if_.ReleaseDataBuffer());
+}
+
 void Node::SwitchCommunication(const SubsystemComm::kMode& _mode) {
   comm_if_.set_mode(_mode);
 }
@@ -237,39 +273,69 @@ void Node::BufferDataLog() {
     log_buffer_.counter = 0;
   }
   int counter = log_buffer_.counter;
-  std::vector<double> geo = orbital_state_.ObtainGeodeticLog();
-  log_buffer_.index[counter] = index_;
-  log_buffer_.constellation[counter] = constellation_;
-  uint64_t mode = 0;
-  switch (mode_) {
-  case(kMode::Free):
-    mode = 0;
-    break;
-  case(kMode::Sensing):
-    mode = 1;
-    break;
-  default:
-    mode = 0;
-    break;
+  PartialLog log;
+  ObtainLog(&log);
+  log_buffer_.index[counter] = log.index_;
+  log_buffer_.constellation[counter] = log.constellation_;
+  log_buffer_.mode[counter] = log.mode_;
+  log_buffer_.latitude[counter] = log.latitude_;
+  log_buffer_.longitude[counter] = log.longitude_;
+  log_buffer_.altitude[counter] = log.altitude_;
+  log_buffer_.energy[counter] = log.energy_;
+  log_buffer_.charging[counter] = log.charging_;
+  log_buffer_.area[counter] = log.area_;
+  log_buffer_.num_neighbors[counter] = log.num_neighbors_;
+  ++log_buffer_.counter;
+}
+
+void Node::ObtainLog(PartialLog* _log) const {
+  ObtainLog({true, true, true, true, true, true, true, true}, _log);
+}
+
+void Node::ObtainLog(const LogMask& _mask, PartialLog* _log) const {
+  _log->index_ = index_;
+  if (_mask.constellation_) {
+    _log->constellation_ = constellation_;
   }
-  if (comm_if_.mode() == SubsystemComm::kMode::Transmitting) {
-    mode = 2;
-  } else if (comm_if_.mode() == SubsystemComm::kMode::Receiving) {
-    mode = 3;
+  if (_mask.mode_) {
+    uint64_t mode = 0;
+    switch (mode_) {
+    case(kMode::Free):
+      mode = 0;
+      break;
+    case(kMode::Sensing):
+      mode = 1;
+      break;
+    default:
+      mode = 0;
+      break;
+    }
+    if (comm_if_.mode() == SubsystemComm::kMode::Transmitting) {
+      mode = 2;
+    } else if (comm_if_.mode() == SubsystemComm::kMode::Receiving) {
+      mode = 3;
+    }
+    _log->mode_ = mode;
+  }
+  if (_mask.position_) {
+    const Geodetic& geodetic = orbital_state_.geodetic_rad_m();
+    _log->latitude_ = geodetic.latitude_rad();
+    _log->longitude_ = geodetic.longitude_rad();
+    _log->altitude_ = geodetic.altitude_m();
+  }
+  if (_mask.energy_) {
+    _log->energy_ = subsystem_power_.battery().energy_w_hr();
+  }
+  if (_mask.charging_) {
+    _log->charging_ = subsystem_power_.charging();
+  }
+  if (_mask.area_) {
+    // Computed by the last power update
+    _log->area_ = subsystem_power_.solar_panels()[0].effective_area_m2();
+  }
+  if (_mask.num_neighbors_) {
+    _log->num_neighbors_ = num_neighbors_;
   }
-  log_buffer_.mode[counter] = mode;
-  log_buffer_.latitude[counter] = geo[0];
-  log_buffer_.longitude[counter] = geo[1];
-  log_buffer_.altitude[counter] = geo[2];
-  SolarPanel panel = subsystem_power_.solar_panels()[0];
-  panel.Update(orbital_state_.body_frame(),
-               orbital_state_.orbit_frame(),
-               orbital_state_.position_m_rad());
-  log_buffer_.energy[counter] = subsystem_power_.battery().energy_w_hr();
-  log_buffer_.charging[counter] = subsystem_power_.charging();
-  log_buffer_.area[counter] = panel.effective_area_m2();
-  log_buffer_.num_neighbors[counter] = num_neighbors_;
-  ++log_buffer_.counter;
 }
 
 void Node::Flush() {
@@ -329,21 +395,25 @@ void Node::Flush() {
 }
 
 void Node::SetCommBuffer(std::vector<uint8_t> _comm_buffer) {
-  comm_if_.set_data_buffer(_comm_buffer);
+  comm_if_.set_data_buffer(std::move(_comm_buffer));
 }
 
 void Node::SetSensingBuffer(std::vector<uint8_t> _sensing_buffer) {
-  sensing_if_.set_data_buffer(_sensing_buffer);
+  sensing_if_.set_data_buffer(std::move(_sensing_buffer));
 }
 
-std::vector<uint8_t> Node::GetCommBuffer() {
+const std::vector<uint8_t>& Node::GetCommBuffer() const {
   return comm_if_.data_buffer();
 }
 
-std::vector<uint8_t> Node::GetSensingBuffer() {
+const std::vector<uint8_t>& Node::GetSensingBuffer() const {
   return sensing_if_.data_buffer();
 }
 
+std::vector<uint8_t> Node::ReleaseCommBuffer() {
+  return comm_if_.ReleaseDataBuffer();
+}
+
 void Node::EraseCommBuffer() {
   comm_if_.EraseDataBuffer();
 }
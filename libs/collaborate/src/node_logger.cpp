@@ -0,0 +1,286 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "collaborate/node_logger.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "collaborate/data_logger.h"
+#include "collaborate/node.h"
+#include "collaborate/trace_logger.h"
+#include "collaborate/util.h"
+
+namespace osse {
+namespace collaborate {
+
+constexpr double NodeLogger::kFillDouble;
+constexpr int8_t NodeLogger::kFillByte;
+constexpr uint16_t NodeLogger::kFillUshort;
+constexpr uint64_t NodeLogger::kFillUint64;
+
+NodeLogger::NodeLogger(DataLogger* _data_log, const uint16_t& _num_nodes)
+    : data_log_(_data_log),
+      trace_log_(nullptr),
+      num_nodes_(_num_nodes),
+      buffer_({}),
+      last_({}),
+      policy_({{kRate::Every, 1},
+               {kRate::Every, 1},
+               {kRate::Every, 1},
+               {kRate::Every, 1},
+               {kRate::Every, 1},
+               {kRate::Every, 1},
+               {kRate::Every, 1},
+               {kRate::Every, 1}}),
+      constellations_({}),
+      counter_(0),
+      num_logged_(0) {
+  Allocate();
+}
+
+NodeLogger::NodeLogger(TraceLogger* _trace_log, const uint16_t& _num_nodes)
+    : data_log_(nullptr),
+      trace_log_(_trace_log),
+      num_nodes_(_num_nodes),
+      buffer_({}),
+      last_({}),
+      policy_({{kRate::Every, 1},
+               {kRate::Every, 1},
+               {kRate::Every, 1},
+               {kRate::Every, 1},
+               {kRate::Every, 1},
+               {kRate::Every, 1},
+               {kRate::Every, 1},
+               {kRate::Every, 1}}),
+      constellations_({}),
+      counter_(0),
+      num_logged_(0) {
+  Allocate();
+}
+
+void NodeLogger::Allocate() {
+  uint64_t size = num_nodes_ * Node::kLogBufferSize;
+  buffer_.index.resize(size);
+  buffer_.constellation.resize(size);
+  buffer_.mode.resize(size);
+  buffer_.latitude.resize(size);
+  buffer_.longitude.resize(size);
+  buffer_.altitude.resize(size);
+  buffer_.energy.resize(size);
+  buffer_.charging.resize(size);
+  buffer_.area.resize(size);
+  buffer_.num_neighbors.resize(size);
+  Clear(&buffer_);
+  last_.index.resize(num_nodes_);
+  last_.constellation.resize(num_nodes_);
+  last_.mode.resize(num_nodes_);
+  last_.latitude.resize(num_nodes_);
+  last_.longitude.resize(num_nodes_);
+  last_.altitude.resize(num_nodes_);
+  last_.energy.resize(num_nodes_);
+  last_.charging.resize(num_nodes_);
+  last_.area.resize(num_nodes_);
+  last_.num_neighbors.resize(num_nodes_);
+  Clear(&last_);
+}
+
+void NodeLogger::Clear(LogBuffer* _buffer) const {
+  std::fill(_buffer->index.begin(), _buffer->index.end(), kFillUshort);
+  std::fill(_buffer->constellation.begin(),
+            _buffer->constellation.end(),
+            kFillUshort);
+  std::fill(_buffer->mode.begin(), _buffer->mode.end(), kFillUint64);
+  std::fill(_buffer->latitude.begin(), _buffer->latitude.end(), kFillDouble);
+  std::fill(_buffer->longitude.begin(),
+            _buffer->longitude.end(),
+            kFillDouble);
+  std::fill(_buffer->altitude.begin(), _buffer->altitude.end(), kFillDouble);
+  std::fill(_buffer->energy.begin(), _buffer->energy.end(), kFillDouble);
+  std::fill(_buffer->charging.begin(), _buffer->charging.end(), kFillByte);
+  std::fill(_buffer->area.begin(), _buffer->area.end(), kFillDouble);
+  std::fill(_buffer->num_neighbors.begin(),
+            _buffer->num_neighbors.end(),
+            kFillUshort);
+}
+
+void NodeLogger::set_constellation_logged(const uint16_t& _constellation,
+                                          const bool& _logged) {
+  if (_constellation >= constellations_.size()) {
+    constellations_.resize(_constellation + 1, true);
+  }
+  constellations_[_constellation] = _logged;
+}
+
+bool NodeLogger::Due(const uint16_t& _constellation,
+                     Node::LogMask* _mask) const {
+  if ((_constellation < constellations_.size())
+      && !constellations_[_constellation]) {
+    return false;
+  }
+  _mask->index_ = Scheduled(policy_.index);
+  _mask->constellation_ = Scheduled(policy_.constellation);
+  _mask->mode_ = Scheduled(policy_.mode);
+  _mask->position_ = Scheduled(policy_.position);
+  _mask->energy_ = Scheduled(policy_.energy);
+  _mask->charging_ = Scheduled(policy_.charging);
+  _mask->area_ = Scheduled(policy_.area);
+  _mask->num_neighbors_ = Scheduled(policy_.num_neighbors);
+  return _mask->index_ || _mask->constellation_ || _mask->mode_
+      || _mask->position_ || _mask->energy_ || _mask->charging_
+      || _mask->area_ || _mask->num_neighbors_;
+}
+
+bool NodeLogger::Scheduled(const LogRate& _rate) const {
+  switch (_rate.rate) {
+  case(kRate::Every):
+    return (num_logged_ + counter_) % std::max<uint64_t>(_rate.period_ticks, 1)
+        == 0;
+  case(kRate::Change):
+    return true;
+  default:
+    return false;
+  }
+}
+
+void NodeLogger::Buffer(const Node::LogMask& _mask,
+                        const Node::PartialLog& _log) {
+  uint16_t n = _log.index_;
+  if (n >= num_nodes_) {
+    return;
+  }
+  uint64_t i = util::Index(n, counter_, Node::kLogBufferSize);
+  if (_mask.index_) {
+    Stage(policy_.index, _log.index_, &last_.index[n], &buffer_.index[i]);
+  }
+  if (_mask.constellation_) {
+    Stage(policy_.constellation,
+          _log.constellation_,
+          &last_.constellation[n],
+          &buffer_.constellation[i]);
+  }
+  if (_mask.mode_) {
+    Stage(policy_.mode, _log.mode_, &last_.mode[n], &buffer_.mode[i]);
+  }
+  if (_mask.position_) {
+    Stage(policy_.position,
+          _log.latitude_,
+          &last_.latitude[n],
+          &buffer_.latitude[i]);
+    Stage(policy_.position,
+          _log.longitude_,
+          &last_.longitude[n],
+          &buffer_.longitude[i]);
+    Stage(policy_.position,
+          _log.altitude_,
+          &last_.altitude[n],
+          &buffer_.altitude[i]);
+  }
+  if (_mask.energy_) {
+    Stage(policy_.energy, _log.energy_, &last_.energy[n], &buffer_.energy[i]);
+  }
+  if (_mask.charging_) {
+    Stage(policy_.charging,
+          static_cast<int8_t>(_log.charging_),
+          &last_.charging[n],
+          &buffer_.charging[i]);
+  }
+  if (_mask.area_) {
+    Stage(policy_.area, _log.area_, &last_.area[n], &buffer_.area[i]);
+  }
+  if (_mask.num_neighbors_) {
+    Stage(policy_.num_neighbors,
+          _log.num_neighbors_,
+          &last_.num_neighbors[n],
+          &buffer_.num_neighbors[i]);
+  }
+}
+
+void NodeLogger::Advance() {
+  ++counter_;
+  if (counter_ == Node::kLogBufferSize) {
+    Flush();
+  }
+}
+
+void NodeLogger::Flush() {
+  uint64_t count = counter_;
+  if (count == 0) {
+    return;
+  }
+  // Pack a partial buffer so each node's ticks are contiguous
+  if (count < Node::kLogBufferSize) {
+    for (uint16_t n = 1; n < num_nodes_; ++n) {
+      uint64_t from = util::Index(n, 0, Node::kLogBufferSize);
+      uint64_t to = util::Index(n, 0, count);
+      std::copy(&buffer_.index[from], &buffer_.index[from] + count,
+                &buffer_.index[to]);
+      std::copy(&buffer_.constellation[from],
+                &buffer_.constellation[from] + count,
+                &buffer_.constellation[to]);
+      std::copy(&buffer_.mode[from], &buffer_.mode[from] + count,
+                &buffer_.mode[to]);
+      std::copy(&buffer_.latitude[from], &buffer_.latitude[from] + count,
+                &buffer_.latitude[to]);
+      std::copy(&buffer_.longitude[from], &buffer_.longitude[from] + count,
+                &buffer_.longitude[to]);
+      std::copy(&buffer_.altitude[from], &buffer_.altitude[from] + count,
+                &buffer_.altitude[to]);
+      std::copy(&buffer_.energy[from], &buffer_.energy[from] + count,
+                &buffer_.energy[to]);
+      std::copy(&buffer_.charging[from], &buffer_.charging[from] + count,
+                &buffer_.charging[to]);
+      std::copy(&buffer_.area[from], &buffer_.area[from] + count,
+                &buffer_.area[to]);
+      std::copy(&buffer_.num_neighbors[from],
+                &buffer_.num_neighbors[from] + count,
+                &buffer_.num_neighbors[to]);
+    }
+  }
+  // Parameters that are never logged keep their fill value in the file
+  if (policy_.index.rate != kRate::Off) {
+    Log("index", buffer_.index.data(), count);
+  }
+  if (policy_.constellation.rate != kRate::Off) {
+    Log("constellation", buffer_.constellation.data(), count);
+  }
+  if (policy_.mode.rate != kRate::Off) {
+    Log("mode", buffer_.mode.data(), count);
+  }
+  if (policy_.position.rate != kRate::Off) {
+    Log("latitude", buffer_.latitude.data(), count);
+    Log("longitude", buffer_.longitude.data(), count);
+    Log("altitude", buffer_.altitude.data(), count);
+  }
+  if (policy_.energy.rate != kRate::Off) {
+    Log("energy", buffer_.energy.data(), count);
+  }
+  if (policy_.charging.rate != kRate::Off) {
+    Log("charging", buffer_.charging.data(), count);
+  }
+  if (policy_.area.rate != kRate::Off) {
+    Log("area", buffer_.area.data(), count);
+  }
+  if (policy_.num_neighbors.rate != kRate::Off) {
+    Log("num_neighbors", buffer_.num_neighbors.data(), count);
+  }
+  Clear(&buffer_);
+  num_logged_ += count;
+  counter_ = 0;
+}
+
+}  // namespace collaborate
+}  // namespace osse
@@ -16,12 +16,14 @@
 #include "collaborate/observing_system.h"
 
 #include <cstdint>
+#include <set>
 #include <vector>
 
 #include "collaborate/data_logger.h"
 #include "collaborate/data_processor.h"
 #include "collaborate/event_logger.h"
 #include "collaborate/node.h"
+#include "collaborate/node_logger.h"
 #include "collaborate/platform_earth.h"
 #include "collaborate/platform_orbit.h"
 #include "collaborate/scheduler.h"
@@ -42,7 +44,8 @@ ObservingSystem::ObservingSystem(Sun* _sun,
       nodes_(std::vector<Node*>()),
       num_samples_(0),
       event_log_(_event_log),
-      sun_(_sun) {
+      sun_(_sun),
+      node_log_(nullptr) {
 }
 
 ObservingSystem::~ObservingSystem() {
@@ -53,14 +56,36 @@ ObservingSystem::~ObservingSystem() {
 }
 
 void ObservingSystem::LogNodes() const {
+  if (node_log_ != nullptr) {
+    Node::PartialLog log;
+    Node::LogMask mask;
+    for (auto node : nodes_) {
+      if (node_log_->Due(node->constellation(), &mask)) {
+        node->ObtainLog(mask, &log);
+        node_log_->Buffer(mask, log);
+      }
+    }
+    node_log_->Advance();
+    return;
+  }
   for (auto node : nodes_) {
     node->BufferDataLog();
   }
 }
 
 void ObservingSystem::Complete() const {
+  if (node_log_ != nullptr) {
+    node_log_->Flush();
+  }
+  std::set<DataLogger*> data_logs;
   for (auto node : nodes_) {
-    node->Flush();
+    if (node_log_ == nullptr) {
+      node->Flush();
+    }
+    data_logs.insert(node->data_log());
+  }
+  for (auto data_log : data_logs) {
+    data_log->Wait();
   }
 }
 
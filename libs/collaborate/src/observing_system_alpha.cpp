@@ -52,6 +52,19 @@ ObservingSystemAlpha::ObservingSystemAlpha(Sun* _sun,
       flag_(_flag) {
 }
 
+ObservingSystemAlpha::ObservingSystemAlpha(Sun* _sun,
+                                           SimulationClock* _clock,
+                                           Scheduler* _scheduler,
+                                           EventLogger* _event_log,
+                                           DataLogger* _network_log,
+                                           const bool& _flag,
+                                           const uint64_t& _snapshot_ticks)
+    : ObservingSystem(_sun, _clock, _scheduler, _event_log),
+      unweighted_(GraphUnweighted(_network_log, _snapshot_ticks)),
+      channels_(std::vector<Channel>()),
+      flag_(_flag) {
+}
+
 void ObservingSystemAlpha::Seed(const uint64_t& _span_s) {
   for (auto &node : nodes_) {
     uint64_t time_s = util::RandomNumberBetween(0, _span_s/30);
@@ -110,7 +123,11 @@ void ObservingSystemAlpha::Update() {
   constexpr uint64_t kOffsetS = 0;
   sun_->Update(kOffsetS);
   for (auto &node : nodes_) {
-    node->Update(kOffsetS, true, true, true, true, true, true);
+    node->Update(kOffsetS, true, true, false, true, false, true);
+  }
+  Node::UpdateMeasurements(*clock_, nodes_);
+  for (auto &node : nodes_) {
+    node->UpdatePower(true);
   }
   event_log_->log()->debug("[{}] scheduling communications", *clock_);
   scheduler_->Update(nodes_, event_log_);
@@ -143,6 +160,9 @@ void ObservingSystemAlpha::Specular() {
 
 void ObservingSystemAlpha::LinesOfSight() {
   scheduler_->AllLos(&unweighted_);
+  for (auto &node : nodes_) {
+    node->set_num_neighbors(unweighted_.Degree(node->index()));
+  }
   unweighted_.Log(nodes_.size(), clock_->ticks());
 }
 
@@ -152,6 +172,7 @@ void ObservingSystemAlpha::ArbitrateCommunication() {
       Channel channel(node, nodes_[node->target_index()]);
       channel.Update(*clock_, flag_);
       channel.Start();
+      event_log_->TransferStart(*clock_, node->index(), node->target_index());
       channels_.push_back(channel);
       unweighted_.SetEdge(node->index(), node->target_index(), true);
     }
@@ -165,10 +186,8 @@ void ObservingSystemAlpha::ArbitrateCommunication() {
       uint16_t tx_idx = (*channel).tx_node()->index();
       uint16_t rx_idx = (*channel).rx_node()->index();
       unweighted_.SetEdge(tx_idx, rx_idx, false);
-      if (success) {
-        event_log_->log()->info("[{}] N{}>N{} OK", *clock_, tx_idx, rx_idx);
-      } else if (error) {
-        event_log_->log()->warn("[{}] N{}>N{} FAIL", *clock_, tx_idx, rx_idx);
+      if (success || error) {
+        event_log_->TransferEnd(*clock_, tx_idx, rx_idx, success);
       }
       if (!error) {
         (*channel).rx_node()->AddressCommBuffer();
@@ -16,6 +16,7 @@
 #include "collaborate/packet.h"
 
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace osse {
@@ -24,42 +25,39 @@ namespace collaborate {
 Packet::Packet() : payload_(std::vector<uint8_t>()) {
 }
 
-Packet::Packet(const std::vector<uint8_t>& _payload) : payload_(_payload) {
+Packet::Packet(std::vector<uint8_t> _payload)
+    : payload_(std::move(_payload)) {
+}
+
+std::vector<uint8_t> Packet::ReleasePayload() {
+  std::vector<uint8_t> payload;
+  payload.swap(payload_);
+  return payload;
 }
 
 bool Packet::UnpackBool(const std::vector<uint8_t>& _payload,
                         const uint16_t& _index) const {
-  std::vector<uint8_t> local = _payload;
-  uint64_t unpacked = *reinterpret_cast<bool *>(&local[_index]);
-  return unpacked;
+  return Unpack<bool>(_payload.data(), _index);
 }
 
 uint64_t Packet::UnpackUInt64T(const std::vector<uint8_t>& _payload,
                                const uint16_t& _index) const {
-  std::vector<uint8_t> local = _payload;
-  uint64_t unpacked = *reinterpret_cast<uint64_t *>(&local[_index]);
-  return unpacked;
+  return Unpack<uint64_t>(_payload.data(), _index);
 }
 
 uint16_t Packet::UnpackUInt16T(const std::vector<uint8_t>& _payload,
                                const uint16_t& _index) const {
-  std::vector<uint8_t> local = _payload;
-  uint16_t unpacked = *reinterpret_cast<uint16_t *>(&local[_index]);
-  return unpacked;
+  return Unpack<uint16_t>(_payload.data(), _index);
 }
 
 int Packet::UnpackInteger(const std::vector<uint8_t>& _payload,
                           const uint16_t& _index) const {
-  std::vector<uint8_t> local = _payload;
-  int unpacked = *reinterpret_cast<int *>(&local[_index]);
-  return unpacked;
+  return Unpack<int>(_payload.data(), _index);
 }
 
 double Packet::UnpackDouble(const std::vector<uint8_t>& _payload,
                             const uint16_t& _index) const {
-  std::vector<uint8_t> local = _payload;
-  double unpacked = *reinterpret_cast<double *>(&local[_index]);
-  return unpacked;
+  return Unpack<double>(_payload.data(), _index);
 }
 
 }  // namespace collaborate
@@ -19,16 +19,17 @@
 #include <limits>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace osse {
 namespace collaborate {
 
-PacketForward::PacketForward(const std::vector<uint8_t>& _payload)
-    : Packet(_payload),
-      route_(UnpackRoute(_payload)),
-      event_(UnpackEvent(_payload)),
-      feedback_(UnpackFeedback(_payload)) {
+PacketForward::PacketForward(std::vector<uint8_t> _payload)
+    : Packet(std::move(_payload)),
+      route_(UnpackRoute(payload_)),
+      event_(UnpackEvent(payload_)),
+      feedback_(UnpackFeedback(payload_)) {
 }
 
 PacketForward::PacketForward(const PacketForward::PartialRoute& _partial_route,
@@ -53,12 +54,11 @@ std::string PacketForward::ToString() const {
 
 PacketForward::Route PacketForward::UnpackRoute(
     const std::vector<uint8_t>& payload) const {
-  std::vector<uint8_t> local = payload;
   Route route;
   int index = 0;
   for (auto &transfer : route) {
-    transfer.first = UnpackUInt16T(local, index);
-    transfer.second = UnpackUInt64T(local, index+2);
+    transfer.first = UnpackUInt16T(payload, index);
+    transfer.second = UnpackUInt64T(payload, index+2);
     index += kBytesPerTransfer;
   }
   return route;
@@ -67,17 +67,15 @@ PacketForward::Route PacketForward::UnpackRoute(
 
 PacketForward::Event PacketForward::UnpackEvent(
     const std::vector<uint8_t>& payload) const {
-  std::vector<uint8_t> local = payload;
   Event event;
-  event.first = UnpackUInt16T(local, kEventIndex);
-  event.second = UnpackUInt64T(local, kEventIndex+2);
+  event.first = UnpackUInt16T(payload, kEventIndex);
+  event.second = UnpackUInt64T(payload, kEventIndex+2);
   return event;
 }
 
 uint16_t PacketForward::UnpackFeedback(
     const std::vector<uint8_t>& payload) const {
-  std::vector<uint8_t> local = payload;
-  return UnpackUInt16T(local, kFeedbackIndex);
+  return UnpackUInt16T(payload, kFeedbackIndex);
 }
 
 PacketForward::Route PacketForward::EncodeRoute(
@@ -16,30 +16,33 @@
 #include "collaborate/packet_raw.h"
 
 #include <cstdint>
+#include <cstdlib>
+#include <iostream>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace osse {
 namespace collaborate {
 
 PacketRaw::PacketRaw(std::vector<uint8_t> _payload)
-    : Packet(_payload),
-      elapsed_s_(UnpackUInt64T(_payload, kElapsedSIndex)),
-      year_(UnpackInteger(_payload, kYearIndex)),
-      month_(UnpackInteger(_payload, kMonthIndex)),
-      day_(UnpackInteger(_payload, kDayIndex)),
-      hour_(UnpackInteger(_payload, kHourIndex)),
-      minute_(UnpackInteger(_payload, kMinuteIndex)),
-      second_(UnpackInteger(_payload, kSecondIndex)),
-      microsecond_(UnpackInteger(_payload, kMicrosecondIndex)),
-      latitude_rad_(UnpackDouble(_payload, kLatitudeRadIndex)),
-      longitude_rad_(UnpackDouble(_payload, kLongitudeRadIndex)),
-      altitude_m_(UnpackDouble(_payload, kAltitudeMIndex)),
-      measurement_(UnpackDouble(_payload, kMeasurementIndex)),
-      resolution_radius_m_(UnpackDouble(_payload, kResolutionRadMIndex)),
-      name_(UnpackString(_payload, kNameIndex)),
-      informer_index_(UnpackUInt16T(_payload, kInformerIndexIndex)) {
+    : Packet(std::move(_payload)),
+      elapsed_s_(UnpackUInt64T(payload_, kElapsedSIndex)),
+      year_(UnpackInteger(payload_, kYearIndex)),
+      month_(UnpackInteger(payload_, kMonthIndex)),
+      day_(UnpackInteger(payload_, kDayIndex)),
+      hour_(UnpackInteger(payload_, kHourIndex)),
+      minute_(UnpackInteger(payload_, kMinuteIndex)),
+      second_(UnpackInteger(payload_, kSecondIndex)),
+      microsecond_(UnpackInteger(payload_, kMicrosecondIndex)),
+      latitude_rad_(UnpackDouble(payload_, kLatitudeRadIndex)),
+      longitude_rad_(UnpackDouble(payload_, kLongitudeRadIndex)),
+      altitude_m_(UnpackDouble(payload_, kAltitudeMIndex)),
+      measurement_(UnpackDouble(payload_, kMeasurementIndex)),
+      resolution_radius_m_(UnpackDouble(payload_, kResolutionRadMIndex)),
+      name_(UnpackString(payload_, kNameIndex)),
+      informer_index_(UnpackUInt16T(payload_, kInformerIndexIndex)) {
 }
 
 PacketRaw::PacketRaw(const uint64_t& _elapsed_s,
@@ -125,57 +128,116 @@ std::vector<uint8_t> PacketRaw::PackAll(const uint64_t& _elapsed_s,
                                         const std::string& _name,
                                         const uint16_t& _informer_index) {
   std::vector<uint8_t> payload;
-  Pack(_elapsed_s, &payload);
-  Pack(_year, &payload);
-  Pack(_month, &payload);
-  Pack(_day, &payload);
-  Pack(_hour, &payload);
-  Pack(_minute, &payload);
-  Pack(_second, &payload);
-  Pack(_microsecond, &payload);
-  Pack(_latitude_rad, &payload);
-  Pack(_longitude_rad, &payload);
-  Pack(_altitude_m, &payload);
-  Pack(_measurement, &payload);
-  Pack(_resolution_radius_m, &payload);
-  PackString(_name, &payload);
-  Pack(_informer_index, &payload);
+  payload.reserve(kPacketRawSizeBytes);
+  Append(_elapsed_s,
+         _year,
+         _month,
+         _day,
+         _hour,
+         _minute,
+         _second,
+         _microsecond,
+         _latitude_rad,
+         _longitude_rad,
+         _altitude_m,
+         _measurement,
+         _resolution_radius_m,
+         _name,
+         _informer_index,
+         &payload);
   return payload;
 }
 
+void PacketRaw::Append(const uint64_t& _elapsed_s,
+                       const int& _year,
+                       const int& _month,
+                       const int& _day,
+                       const int& _hour,
+                       const int& _minute,
+                       const int& _second,
+                       const int& _microsecond,
+                       const double& _latitude_rad,
+                       const double& _longitude_rad,
+                       const double& _altitude_m,
+                       const double& _measurement,
+                       const double& _resolution_radius_m,
+                       const std::string& _name,
+                       const uint16_t& _informer_index,
+                       std::vector<uint8_t>* _buffer) {
+  Pack(_elapsed_s, _buffer);
+  Pack(_year, _buffer);
+  Pack(_month, _buffer);
+  Pack(_day, _buffer);
+  Pack(_hour, _buffer);
+  Pack(_minute, _buffer);
+  Pack(_second, _buffer);
+  Pack(_microsecond, _buffer);
+  Pack(_latitude_rad, _buffer);
+  Pack(_longitude_rad, _buffer);
+  Pack(_altitude_m, _buffer);
+  Pack(_measurement, _buffer);
+  Pack(_resolution_radius_m, _buffer);
+  PackString(_name, _buffer);
+  Pack(_informer_index, _buffer);
+}
+
 void PacketRaw::PackString(const std::string& _string,
-                           std::vector<uint8_t>* payload) const {
-  std::string local = _string;
-  for (char& c : local) {
-    payload->push_back(*reinterpret_cast<uint8_t *>(&c));
-  }
+                           std::vector<uint8_t>* payload) {
+  payload->insert(payload->end(), _string.begin(), _string.end());
 }
 
 std::string PacketRaw::UnpackString(const std::vector<uint8_t>& payload,
                                     const uint16_t& _index) const {
-  std::vector<uint8_t> local = payload;
-  std::stringstream unpacked;
-  for (int c = 0; c < kMaxStringSize; ++c) {
-    unpacked << *reinterpret_cast<char*>(&local[_index + c]);
-  }
-  return unpacked.str();
+  return std::string(reinterpret_cast<const char*>(&payload[_index]),
+                     kMaxStringSize);
+}
+
+PacketRawView::PacketRawView(const uint8_t* _data) : data_(_data) {
+}
+
+std::string PacketRawView::name() const {
+  return std::string(
+      reinterpret_cast<const char*>(data_ + PacketRaw::kNameIndex),
+      PacketRaw::kMaxStringSize);
 }
 
 std::vector<PacketRaw> ReadRawBuffer(const std::vector<uint8_t>& _buffer) {
   if (_buffer.size() % PacketRaw::kPacketRawSizeBytes != 0) {
-    exit(0);
+    std::cerr << "ReadRawBuffer: " << _buffer.size()
+              << " bytes is not a whole number of "
+              << PacketRaw::kPacketRawSizeBytes << "-byte packets"
+              << std::endl;
+    exit(EXIT_FAILURE);
   }
   uint64_t counter = 0;
   std::vector<PacketRaw> messages;
+  messages.reserve(_buffer.size() / PacketRaw::kPacketRawSizeBytes);
   while (counter < _buffer.size()) {
     int end_index = counter + PacketRaw::kPacketRawSizeBytes;
     std::vector<uint8_t> payload(&_buffer[counter], &_buffer[end_index]);
-    PacketRaw message(payload);
-    messages.push_back(message);
+    messages.push_back(PacketRaw(std::move(payload)));
     counter += PacketRaw::kPacketRawSizeBytes;
   }
   return messages;
 }
 
+std::vector<PacketRawView> ViewRawBuffer(const std::vector<uint8_t>& _buffer) {
+  if (_buffer.size() % PacketRaw::kPacketRawSizeBytes != 0) {
+    std::cerr << "ViewRawBuffer: " << _buffer.size()
+              << " bytes is not a whole number of "
+              << PacketRaw::kPacketRawSizeBytes << "-byte packets"
+              << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::vector<PacketRawView> views;
+  views.reserve(_buffer.size() / PacketRaw::kPacketRawSizeBytes);
+  for (uint64_t counter = 0;
+       counter < _buffer.size();
+       counter += PacketRaw::kPacketRawSizeBytes) {
+    views.push_back(PacketRawView(&_buffer[counter]));
+  }
+  return views;
+}
+
 }  // namespace collaborate
 }  // namespace osse
@@ -25,10 +25,10 @@
 namespace osse {
 namespace collaborate {
 
-PacketReturn::PacketReturn(const std::vector<uint8_t>& _payload)
-    : Packet(_payload),
-      route_(UnpackRoute(_payload)),
-      success_(UnpackSuccess(_payload)) {
+PacketReturn::PacketReturn(std::vector<uint8_t> _payload)
+    : Packet(std::move(_payload)),
+      route_(UnpackRoute(payload_)),
+      success_(UnpackSuccess(payload_)) {
 }
 
 PacketReturn::PacketReturn(const PacketReturn::PartialRoute& _partial_route,
@@ -61,12 +61,11 @@ std::string PacketReturn::ToString() const {
 
 PacketReturn::Route PacketReturn::UnpackRoute(
     const std::vector<uint8_t>& payload) const {
-  std::vector<uint8_t> local = payload;
   Route route;
   int index = 0;
   for (auto &transfer : route) {
-    transfer.first = UnpackUInt16T(local, index);
-    transfer.second = UnpackUInt64T(local, index+2);
+    transfer.first = UnpackUInt16T(payload, index);
+    transfer.second = UnpackUInt64T(payload, index+2);
     index += kBytesPerTransfer;
   }
   return route;
@@ -75,10 +74,9 @@ PacketReturn::Route PacketReturn::UnpackRoute(
 
 std::pair<bool, uint16_t> PacketReturn::UnpackSuccess(
     const std::vector<uint8_t>& payload) const {
-  std::vector<uint8_t> local = payload;
   std::pair<bool, uint16_t> success;
-  success.first = UnpackBool(local, kSuccessIndex);
-  success.second = UnpackUInt16T(local, kSuccessIndex+1);
+  success.first = UnpackBool(payload, kSuccessIndex);
+  success.second = UnpackUInt16T(payload, kSuccessIndex+1);
   return success;
 }
 
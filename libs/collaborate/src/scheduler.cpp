@@ -16,7 +16,6 @@
 #include "collaborate/scheduler.h"
 
 #include <cstdint>
-#include <sstream>
 #include <vector>
 
 #include "collaborate/channel.h"
@@ -26,6 +25,7 @@
 #include "collaborate/node.h"
 #include "collaborate/simulation_clock.h"
 #include "collaborate/tree.h"
+#include "collaborate/tree_logger.h"
 #include "collaborate/vector.h"
 
 namespace osse {
@@ -33,7 +33,8 @@ namespace collaborate {
 
 Scheduler::Scheduler(SimulationClock* _clock)
     : clock_(_clock),
-      nodes_(std::vector<Node*>()) {
+      nodes_(std::vector<Node*>()),
+      tree_log_(nullptr) {
 }
 
 void Scheduler::RestoreNodes() {
@@ -43,18 +44,21 @@ void Scheduler::RestoreNodes() {
 }
 
 void Scheduler::AllLos(GraphUnweighted* _unweighted) {
+  _unweighted->Resize(nodes_.size());
+  // Line of sight is symmetric, so test each pair once
   for (uint16_t i = 0; i < nodes_.size(); ++i) {
-    for (uint16_t j = 0; j < nodes_.size(); ++j) {
-      if (i != j) {
-        Vector tx_pos = nodes_[i]->orbital_state().position_m_rad();
-        Vector rx_pos = nodes_[j]->orbital_state().position_m_rad();
-        _unweighted->SetEdge(i, j, earth::Visible(tx_pos, rx_pos));
-      }
+    Vector tx_pos = nodes_[i]->orbital_state().position_m_rad();
+    for (uint16_t j = i + 1; j < nodes_.size(); ++j) {
+      Vector rx_pos = nodes_[j]->orbital_state().position_m_rad();
+      bool visible = earth::Visible(tx_pos, rx_pos);
+      _unweighted->SetEdge(i, j, visible);
+      _unweighted->SetEdge(j, i, visible);
     }
   }
 }
 
 void Scheduler::AllDist(GraphWeighted* _weighted) {
+  _weighted->Resize(nodes_.size());
   for (uint16_t i = 0; i < nodes_.size(); ++i) {
     for (uint16_t j = 0; j < nodes_.size(); ++j) {
       if (i != j) {
@@ -75,15 +79,10 @@ void Scheduler::AllDist(GraphWeighted* _weighted) {
 void Scheduler::SaveTree(const uint16_t& _start,
                          const uint16_t& _end,
                          const Tree& _tree) {
-  std::stringstream stream;
-  stream << "output/tree_"
-         << _start
-         << "_"
-         << _end
-         << "_"
-         << clock_->elapsed_s()
-         << ".tex";
-  _tree.Log(stream.str());
+  if (tree_log_ == nullptr) {
+    return;
+  }
+  tree_log_->Save(_start, _end, clock_->elapsed_s(), _tree);
 }
 
 }  // namespace collaborate
@@ -18,7 +18,6 @@
 #include <cstdint>
 #include <limits>
 #include <set>
-#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -27,7 +26,6 @@
 #include "collaborate/earth.h"
 #include "collaborate/event_logger.h"
 #include "collaborate/geodetic.h"
-#include "collaborate/graph.h"
 #include "collaborate/node.h"
 #include "collaborate/packet_forward.h"
 #include "collaborate/packet_return.h"
@@ -80,21 +78,15 @@ void SchedulerAlpha::Update(const std::vector<Node*>& _nodes,
       if (NextVisitor(source->min_suggestions(), 2, &next, &prediction_s)) {
         uint64_t limit_s = (prediction_s -
                             (next->sensing_if().sensor()->kDurationS() / 2));
-        _logger->log()->info("[{}] Predicting N{}>...>N{} within {} s",
-                             *clock_,
-                             source->index(),
-                             next->index(),
-                             limit_s);
+        _logger->Prediction(*clock_, source->index(), next->index(), limit_s);
         route = FindRoute(source->index(), next->index(), contact_s, limit_s);
         if (!route.empty()) {
-          _logger->log()->info("[{}] Route found: {}",
-                               *clock_,
-                               GetRouteLog(source->index(), route));
+          _logger->Route(*clock_, source->index(), route);
           uint64_t elapsed_s = clock_->elapsed_s() + limit_s;
           PacketForward packet(route,
                                std::make_pair(next->index(), elapsed_s),
                                source->index());
-          source->SetCommBuffer(packet.payload());
+          source->SetCommBuffer(packet.ReleasePayload());
           source->AddressCommBuffer();
         }
       }
@@ -108,21 +100,15 @@ void SchedulerAlpha::Update(const std::vector<Node*>& _nodes,
         //  std::cout << "yes visitor" << std::endl;
         uint64_t limit_s = (prediction_s -
                             (next->sensing_if().sensor()->kDurationS() / 2));
-        _logger->log()->info("[{}] Predicting N{}>...>N{} within {} s",
-                             *clock_,
-                             source->index(),
-                             next->index(),
-                             limit_s);
+        _logger->Prediction(*clock_, source->index(), next->index(), limit_s);
         route = FindRoute(source->index(), next->index(), contact_s, limit_s);
         if (!route.empty()) {
-          _logger->log()->info("[{}] Route found: {}",
-                               *clock_,
-                               GetRouteLog(source->index(), route));
+          _logger->Route(*clock_, source->index(), route);
           uint64_t elapsed_s = clock_->elapsed_s() + limit_s;
           PacketForward packet(route,
                                std::make_pair(next->index(), elapsed_s),
                                source->index());
-          source->SetCommBuffer(packet.payload());
+          source->SetCommBuffer(packet.ReleasePayload());
           source->AddressCommBuffer();
         } else {
           //  std::cout << "no route" << std::endl;
@@ -138,19 +124,13 @@ void SchedulerAlpha::Update(const std::vector<Node*>& _nodes,
     uint64_t contact_s = sink->comm_if().RequiredTransferDurationS(kSizeB);
     for (auto feedback : sink->feedback()) {
       next = nodes_[feedback.second];
-      _logger->log()->info("[{}] Predicting N{}>...>N{} within {} s",
-                           *clock_,
-                           sink->index(),
-                           next->index(),
-                           limit_s);
+      _logger->Prediction(*clock_, sink->index(), next->index(), limit_s);
       route = FindRoute(sink->index(), next->index(), contact_s, limit_s);
       if (!route.empty()) {
-        _logger->log()->info("[{}] Route found: {}",
-                             *clock_,
-                             GetRouteLog(sink->index(), route));
+        _logger->Route(*clock_, sink->index(), route);
         PacketReturn packet(route, std::make_pair(feedback.first,
                                                   sink->constellation()));
-        sink->SetCommBuffer(packet.payload());
+        sink->SetCommBuffer(packet.ReleasePayload());
         sink->AddressCommBuffer();
       }
     }
@@ -193,14 +173,13 @@ bool SchedulerAlpha::NextVisitor(
   constexpr uint64_t kStopTimeS = 5000;
   constexpr uint64_t kIntervalS = 1;
   constexpr uint64_t kInitialOffsetS = 300;
-  uint64_t wait_interval[Graph::kMaxNodes];
-  std::fill(wait_interval, wait_interval + Graph::kMaxNodes, 0);
   std::vector<Node*> sinks;
   for (auto &node : nodes_) {
     if (node->constellation() == _sink_constellation) {
       sinks.push_back(node);
     }
   }
+  std::vector<uint64_t> wait_interval(sinks.size(), 0);
   bool found = false;
   uint64_t offset_s;
   offset_s = kInitialOffsetS;
@@ -268,10 +247,10 @@ std::vector<std::pair<uint16_t, uint64_t>> SchedulerAlpha::FindRoute(
   bool finished = false;
   Tree::Branch* parent;
   Tree::Branch* child;
-  std::array<uint16_t, Graph::kMaxNodes> level;
-  level.fill(std::numeric_limits<uint16_t>::max());
-  std::array<uint64_t, Graph::kMaxNodes> rcvd;
-  rcvd.fill(std::numeric_limits<uint64_t>::max());
+  std::vector<uint16_t> level(nodes_.size(),
+                              std::numeric_limits<uint16_t>::max());
+  std::vector<uint64_t> rcvd(nodes_.size(),
+                             std::numeric_limits<uint64_t>::max());
   std::set<uint16_t> tx_indices;
   Tree tree(nodes_[_start_node_index], 5, nodes_[_end_node_index]);
   tx_indices.insert(_start_node_index);
@@ -416,16 +395,5 @@ uint64_t SchedulerAlpha::Confirm(Node* _tx_node,
   return result_s;
 }
 
-std::string SchedulerAlpha::GetRouteLog(
-    const uint16_t& _start_index,
-    const std::vector<std::pair<uint16_t, uint64_t>>& _route) {
-  std::stringstream stream;
-  stream << "N" << _start_index;
-  for (auto &transfer : _route) {
-    stream << ">N" << transfer.first;
-  }
-  return stream.str();
-}
-
 }  // namespace collaborate
 }  // namespace osse
@@ -34,6 +34,7 @@ Sensor::Sensor(EarthData* _earth_data,
       kPowerConsumedW_(_power_consumed_w),
       kDurationS_(_duration_s),
       kTargetValue_(_target_value) {
+  EarthData::Track(kVariable_);
 }
 
 void Sensor::Update(const SimulationClock& _clock) const {
@@ -21,6 +21,7 @@
 #include "sgp4/date_time.h"
 
 #include "collaborate/data_logger.h"
+#include "collaborate/trace_logger.h"
 
 namespace osse {
 namespace collaborate {
@@ -31,7 +32,10 @@ SimulationClock::SimulationClock(DataLogger* _data_log)
       elapsed_s_(0),
       ticks_(0),
       data_log_(_data_log),
-      log_buffer_({0, {0}, {0}, {0}, {0}, {0}, {0}, {0}}) {
+      trace_log_(nullptr),
+      num_runs_(0),
+      run_step_s_(0),
+      log_buffer_({0, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}}) {
 }
 
 SimulationClock::SimulationClock(DataLogger* _data_log,
@@ -43,7 +47,10 @@ SimulationClock::SimulationClock(DataLogger* _data_log,
       elapsed_s_(0),
       ticks_(0),
       data_log_(_data_log),
-      log_buffer_({0, {0}, {0}, {0}, {0}, {0}, {0}, {0}}) {
+      trace_log_(nullptr),
+      num_runs_(0),
+      run_step_s_(0),
+      log_buffer_({0, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}}) {
 }
 
 SimulationClock::SimulationClock(DataLogger* _data_log,
@@ -58,23 +65,31 @@ SimulationClock::SimulationClock(DataLogger* _data_log,
       elapsed_s_(0),
       ticks_(0),
       data_log_(_data_log),
-      log_buffer_({0, {0}, {0}, {0}, {0}, {0}, {0}, {0}}) {
+      trace_log_(nullptr),
+      num_runs_(0),
+      run_step_s_(0),
+      log_buffer_({0, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}}) {
 }
 
 void SimulationClock::Tick(const uint64_t& _seconds) {
-  Buffer();
+  Buffer(_seconds);
   last_increment_s_ = _seconds;
   elapsed_s_ += _seconds;
   date_time_ = date_time_.AddSeconds(_seconds);
   ticks_ += 1;
 }
 
-void SimulationClock::Buffer() {
+void SimulationClock::Buffer(const uint64_t& _step_s) {
+  if ((num_runs_ > 0) && (_step_s == run_step_s_)) {
+    return;
+  }
   if (log_buffer_.counter == kLogBufferSize) {
     Flush();
     log_buffer_.counter = 0;
   }
   int counter = log_buffer_.counter;
+  log_buffer_.tick[counter] = ticks_;
+  log_buffer_.step_s[counter] = _step_s;
   log_buffer_.year[counter] = date_time_.Year();
   log_buffer_.month[counter] = date_time_.Month();
   log_buffer_.day[counter] = date_time_.Day();
@@ -83,11 +98,30 @@ void SimulationClock::Buffer() {
   log_buffer_.second[counter] = date_time_.Second();
   log_buffer_.microsecond[counter] = date_time_.Microsecond();
   ++log_buffer_.counter;
+  ++num_runs_;
+  run_step_s_ = _step_s;
 }
 
 void SimulationClock::Flush() {
   uint64_t count = log_buffer_.counter;
-  uint64_t index = ticks_ - count;
+  uint64_t index = num_runs_ - count;
+  if (trace_log_ != nullptr) {
+    trace_log_->LogSeries("step_tick", log_buffer_.tick, index, count);
+    trace_log_->LogSeries("step_s", log_buffer_.step_s, index, count);
+    trace_log_->LogSeries("year", log_buffer_.year, index, count);
+    trace_log_->LogSeries("month", log_buffer_.month, index, count);
+    trace_log_->LogSeries("day", log_buffer_.day, index, count);
+    trace_log_->LogSeries("hour", log_buffer_.hour, index, count);
+    trace_log_->LogSeries("minute", log_buffer_.minute, index, count);
+    trace_log_->LogSeries("second", log_buffer_.second, index, count);
+    trace_log_->LogSeries("microsecond",
+                          log_buffer_.microsecond,
+                          index,
+                          count);
+    return;
+  }
+  data_log_->LogSeries("step_tick", log_buffer_.tick, index, count);
+  data_log_->LogSeries("step_s", log_buffer_.step_s, index, count);
   data_log_->LogDateTime("year", log_buffer_.year, index, count);
   data_log_->LogDateTime("month", log_buffer_.month, index, count);
   data_log_->LogDateTime("day", log_buffer_.day, index, count);
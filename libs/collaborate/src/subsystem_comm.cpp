@@ -17,6 +17,7 @@
 
 #include <cstdint>
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "collaborate/antenna.h"
@@ -51,7 +52,7 @@ uint16_t SubsystemComm::Update(const SimulationClock& _clock) {
     if (_clock.elapsed_s() > (*event).elapsed_s_) {
       found = true;
       target_index = (*event).index_;
-      data_buffer_ = (*event).packet_.payload();
+      data_buffer_ = (*event).packet_.ReleasePayload();
       storage_.erase(event);
     } else {
       ++event;
@@ -62,7 +63,7 @@ uint16_t SubsystemComm::Update(const SimulationClock& _clock) {
     if (_clock.elapsed_s() > (*feedback).elapsed_s_) {
       found = true;
       target_index = (*feedback).index_;
-      data_buffer_ = (*feedback).packet_.payload();
+      data_buffer_ = (*feedback).packet_.ReleasePayload();
       feedback_storage_.erase(feedback);
     } else {
       ++feedback;
@@ -103,12 +104,12 @@ double SubsystemComm::CalculatePowerDrainW() {
 }
 
 void SubsystemComm::AddToStorage(SubsystemComm::CommunicationEvent _event) {
-  storage_.push_back(_event);
+  storage_.push_back(std::move(_event));
 }
 
 void SubsystemComm::AddToStorage(
     SubsystemComm::FeedbackEvent _feedback_event) {
-  feedback_storage_.push_back(_feedback_event);
+  feedback_storage_.push_back(std::move(_feedback_event));
 }
 
 void SubsystemComm::OrientAntenna(const ReferenceFrame& _orbit_frame,
@@ -117,18 +118,21 @@ void SubsystemComm::OrientAntenna(const ReferenceFrame& _orbit_frame,
 }
 
 void SubsystemComm::LoadData(const std::vector<uint8_t>& _payload) {
-  for (auto byte : _payload) {
-    data_buffer_.push_back(byte);
-  }
+  data_buffer_.insert(data_buffer_.end(), _payload.begin(), _payload.end());
 }
 
 void SubsystemComm::EraseDataBuffer() {
-  std::vector<uint8_t> empty;
-  data_buffer_ = empty;
+  data_buffer_.clear();
+}
+
+std::vector<uint8_t> SubsystemComm::ReleaseDataBuffer() {
+  std::vector<uint8_t> data_buffer;
+  data_buffer.swap(data_buffer_);
+  return data_buffer;
 }
 
-void SubsystemComm::set_data_buffer(const std::vector<uint8_t>& _data_buffer) {
-  data_buffer_ = _data_buffer;
+void SubsystemComm::set_data_buffer(std::vector<uint8_t> _data_buffer) {
+  data_buffer_ = std::move(_data_buffer);
 }
 
 void SubsystemComm::set_mode(const SubsystemComm::kMode& _mode) {
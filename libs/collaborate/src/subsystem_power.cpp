@@ -50,7 +50,7 @@ void SubsystemPower::Update(const bool& _charge,
   // Add energy received from each solar panel
   double accumulated_energy_w_hr = 0;
   bool charging = false;
-  for (auto panel : solar_panels_) {
+  for (auto& panel : solar_panels_) {
     panel.Update(_body_frame, _orbit_frame, _position_m_rad);
     accumulated_energy_w_hr += (panel.RxPowerW()
                                 * _clock.last_increment_s()
@@ -16,35 +16,71 @@
 #include "collaborate/subsystem_sensing.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <limits>
+#include <map>
 #include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "collaborate/antenna.h"
 #include "collaborate/data_logger.h"
+#include "collaborate/earth_data.h"
 #include "collaborate/geodetic.h"
+#include "collaborate/measurement_logger.h"
 #include "collaborate/packet_raw.h"
 #include "collaborate/reference_frame.h"
 #include "collaborate/sensor.h"
 #include "collaborate/simulation_clock.h"
+#include "collaborate/vector.h"
 
 namespace osse {
 namespace collaborate {
 
+constexpr double SubsystemSensing::kMaxHalfBeamwidthRad;
+constexpr double SubsystemSensing::kMinCosIncidence;
+
 SubsystemSensing::SubsystemSensing(const Antenna* _antenna,
                                    Sensor* _sensor)
     : sensor_(_sensor),
       expiration_s_(std::numeric_limits<uint64_t>::max()),
       complete_(false),
       informer_index_(std::numeric_limits<uint16_t>::max()),
+      name_(Pad(_sensor->kVariable())),
       buffer_({}),
+      measurement_log_(nullptr),
       kAntenna_(_antenna),
       antenna_frame_(ReferenceFrame(kAntenna_->kRollRad(),
                                     kAntenna_->kPitchRad(),
                                     kAntenna_->kYawRad())),
       data_buffer_(std::vector<uint8_t>()),
       active_(false),
-      elapsed_s_(0) {
+      elapsed_s_(0),
+      half_beamwidth_rad_(kAntenna_->BeamwidthRad() / 2),
+      footprint_(false) {
+}
+
+SubsystemSensing::SubsystemSensing(const Antenna* _antenna,
+                                   Sensor* _sensor,
+                                   MeasurementLogger* _measurement_log)
+    : sensor_(_sensor),
+      expiration_s_(std::numeric_limits<uint64_t>::max()),
+      complete_(false),
+      informer_index_(std::numeric_limits<uint16_t>::max()),
+      name_(Pad(_sensor->kVariable())),
+      buffer_({}),
+      measurement_log_(_measurement_log),
+      kAntenna_(_antenna),
+      antenna_frame_(ReferenceFrame(kAntenna_->kRollRad(),
+                                    kAntenna_->kPitchRad(),
+                                    kAntenna_->kYawRad())),
+      data_buffer_(std::vector<uint8_t>()),
+      active_(false),
+      elapsed_s_(0),
+      half_beamwidth_rad_(kAntenna_->BeamwidthRad() / 2),
+      footprint_(false) {
 }
 
 void SubsystemSensing::Measure(const uint16_t& _informer_index) {
@@ -56,97 +92,222 @@ void SubsystemSensing::Measure(const uint16_t& _informer_index) {
 
 bool SubsystemSensing::Update(const SimulationClock& _clock,
                               const Vector& _position_m_rad, const int _node_index) {
+  Geodetic place_rad_m;
+  double radius_m;
+  if (Aim(_clock, _position_m_rad, &place_rad_m, &radius_m)) {
+    double measurement;
+    measurement = sensor_->earth_data()->MeasureFootprint(
+        place_rad_m.latitude_rad(),
+        place_rad_m.longitude_rad(),
+        radius_m);
+    Record(_clock, place_rad_m, measurement, radius_m, _node_index);
+  }
+  return active_;
+}
+
+void SubsystemSensing::UpdateSwath(
+    const SimulationClock& _clock,
+    const std::vector<SubsystemSensing*>& _sensing,
+    const std::vector<Vector>& _positions_m_rad,
+    const std::vector<int>& _node_indices) {
+  // Ground points of every active boresight, grouped by earth_data
+  std::vector<Geodetic> places(_sensing.size());
+  std::vector<double> radii_m(_sensing.size());
+  std::map<EarthData*, std::vector<uint64_t>> swaths;
+  for (uint64_t i = 0; i < _sensing.size(); ++i) {
+    if (_sensing[i]->Aim(_clock,
+                         _positions_m_rad[i],
+                         &places[i],
+                         &radii_m[i])) {
+      swaths[_sensing[i]->sensor_->earth_data()].push_back(i);
+    }
+  }
+  std::vector<double> latitudes_rad;
+  std::vector<double> longitudes_rad;
+  std::vector<double> swath_radii_m;
+  std::vector<float> samples;
+  for (auto& swath : swaths) {
+    latitudes_rad.clear();
+    longitudes_rad.clear();
+    swath_radii_m.clear();
+    for (auto i : swath.second) {
+      latitudes_rad.push_back(places[i].latitude_rad());
+      longitudes_rad.push_back(places[i].longitude_rad());
+      swath_radii_m.push_back(radii_m[i]);
+    }
+    swath.first->Measure(latitudes_rad,
+                         longitudes_rad,
+                         swath_radii_m,
+                         &samples);
+    for (uint64_t j = 0; j < swath.second.size(); ++j) {
+      uint64_t i = swath.second[j];
+      _sensing[i]->Record(_clock,
+                          places[i],
+                          samples[j],
+                          radii_m[i],
+                          _node_indices[i]);
+    }
+  }
+}
+
+bool SubsystemSensing::Aim(const SimulationClock& _clock,
+                           const Vector& _position_m_rad,
+                           Geodetic* _place,
+                           double* _radius_m) {
+  *_radius_m = 0;
   if (active_) {
     sensor_->Update(_clock);
     // From intersection with Earth's surface
-    Geodetic place_rad_m(_position_m_rad,
-                         antenna_frame_.z_axis(),
-                         _clock,
-                         0);
-    double measurement;
-    measurement = sensor_->earth_data()->Measure(place_rad_m.latitude_rad(),
-                                                 place_rad_m.longitude_rad());
-    std::stringstream stream;
-    stream << std::setw(30) << std::setfill(' ') << sensor_->kVariable();
-    PacketRaw packet(_clock.elapsed_s(),
-                     _clock.date_time().Year(),
-                     _clock.date_time().Month(),
-                     _clock.date_time().Day(),
-                     _clock.date_time().Hour(),
-                     _clock.date_time().Minute(),
-                     _clock.date_time().Second(),
-                     _clock.date_time().Microsecond(),
-                     place_rad_m.latitude_rad(),
-                     place_rad_m.longitude_rad(),
-                     place_rad_m.altitude_m(),
-                     measurement,
-                     0,
-                     stream.str(),
-                     // _node_index);  // informer_index_);
-                     informer_index_);
-    LoadData(packet.payload());
-    buffer_.elapsed_s.push_back(_clock.elapsed_s());
-    buffer_.year.push_back(_clock.date_time().Year());
-    buffer_.month.push_back(_clock.date_time().Month());
-    buffer_.day.push_back(_clock.date_time().Day());
-    buffer_.hour.push_back(_clock.date_time().Hour());
-    buffer_.minute.push_back(_clock.date_time().Minute());
-    buffer_.second.push_back(_clock.date_time().Second());
-    buffer_.microsecond.push_back(_clock.date_time().Microsecond());
-    buffer_.latitude_rad.push_back(place_rad_m.latitude_rad());
-    buffer_.longitude_rad.push_back(place_rad_m.longitude_rad());
-    buffer_.altitude_m.push_back(place_rad_m.altitude_m());
-    buffer_.measurement.push_back(measurement);
-    buffer_.resolution_m.push_back(0);
-    // buffer_.index.push_back(_node_index);  // (informer_index_);
-    buffer_.index.push_back(informer_index_);
-    if (elapsed_s_ < expiration_s_) {
-      elapsed_s_ += _clock.last_increment_s();
-    } else {
-      Flush(_clock, _node_index);
-      active_ = false;
-      complete_ = true;
-      expiration_s_ = std::numeric_limits<uint64_t>::max();
-      informer_index_ = std::numeric_limits<uint16_t>::max();
+    *_place = Geodetic(_position_m_rad, antenna_frame_.z_axis(), _clock, 0);
+    if (footprint_) {
+      *_radius_m = FootprintRadiusM(_clock, _position_m_rad, *_place);
     }
   }
   return active_;
 }
 
+double SubsystemSensing::FootprintRadiusM(const SimulationClock& _clock,
+                                          const Vector& _position_m_rad,
+                                          const Geodetic& _place) const {
+  if (half_beamwidth_rad_ <= Antenna::kNoBeamwidthRad) {
+    // No half-power crossing (e.g. a dipole), so a single grid cell
+    return EarthData::kCellRadiusM;
+  }
+  Vector ground_m_rad = _place.ToVector(_clock);
+  Vector line_of_sight = _position_m_rad - ground_m_rad;
+  double range_m = std::sqrt(line_of_sight.Dot(line_of_sight));
+  double cos_incidence = line_of_sight.Unit().Dot(ground_m_rad.Unit());
+  cos_incidence = std::max(cos_incidence, kMinCosIncidence);
+  double half_rad = std::min(half_beamwidth_rad_, kMaxHalfBeamwidthRad);
+  return range_m * std::tan(half_rad) / std::sqrt(cos_incidence);
+}
+
+void SubsystemSensing::Record(const SimulationClock& _clock,
+                              const Geodetic& _place,
+                              const double& _measurement,
+                              const double& _radius_m,
+                              const int _node_index) {
+  double resolution_m = footprint_ ? _radius_m : 0;
+  if (buffer_.elapsed_s.empty()) {
+    uint64_t step_s = std::max<uint64_t>(_clock.last_increment_s(), 1);
+    Reserve(expiration_s_ / step_s + 2);
+  }
+  int year;
+  int month;
+  int day;
+  _clock.date_time().FromTicks(&year, &month, &day);
+  int hour = _clock.date_time().Hour();
+  int minute = _clock.date_time().Minute();
+  int second = _clock.date_time().Second();
+  int microsecond = _clock.date_time().Microsecond();
+  PacketRaw::Append(_clock.elapsed_s(),
+                    year,
+                    month,
+                    day,
+                    hour,
+                    minute,
+                    second,
+                    microsecond,
+                    _place.latitude_rad(),
+                    _place.longitude_rad(),
+                    _place.altitude_m(),
+                    _measurement,
+                    resolution_m,
+                    name_,
+                    // _node_index);  // informer_index_);
+                    informer_index_,
+                    &data_buffer_);
+  buffer_.elapsed_s.push_back(_clock.elapsed_s());
+  buffer_.year.push_back(year);
+  buffer_.month.push_back(month);
+  buffer_.day.push_back(day);
+  buffer_.hour.push_back(hour);
+  buffer_.minute.push_back(minute);
+  buffer_.second.push_back(second);
+  buffer_.microsecond.push_back(microsecond);
+  buffer_.latitude_rad.push_back(_place.latitude_rad());
+  buffer_.longitude_rad.push_back(_place.longitude_rad());
+  buffer_.altitude_m.push_back(_place.altitude_m());
+  buffer_.measurement.push_back(_measurement);
+  buffer_.resolution_m.push_back(resolution_m);
+  // buffer_.index.push_back(_node_index);  // (informer_index_);
+  buffer_.index.push_back(informer_index_);
+  if (elapsed_s_ < expiration_s_) {
+    elapsed_s_ += _clock.last_increment_s();
+  } else {
+    Flush(_clock, _node_index);
+    active_ = false;
+    complete_ = true;
+    expiration_s_ = std::numeric_limits<uint64_t>::max();
+    informer_index_ = std::numeric_limits<uint16_t>::max();
+  }
+}
+
+void SubsystemSensing::Reserve(const uint64_t& _num_samples) {
+  buffer_.elapsed_s.reserve(_num_samples);
+  buffer_.year.reserve(_num_samples);
+  buffer_.month.reserve(_num_samples);
+  buffer_.day.reserve(_num_samples);
+  buffer_.hour.reserve(_num_samples);
+  buffer_.minute.reserve(_num_samples);
+  buffer_.second.reserve(_num_samples);
+  buffer_.microsecond.reserve(_num_samples);
+  buffer_.latitude_rad.reserve(_num_samples);
+  buffer_.longitude_rad.reserve(_num_samples);
+  buffer_.altitude_m.reserve(_num_samples);
+  buffer_.measurement.reserve(_num_samples);
+  buffer_.resolution_m.reserve(_num_samples);
+  buffer_.index.reserve(_num_samples);
+  data_buffer_.reserve(data_buffer_.size()
+                       + _num_samples * PacketRaw::kPacketRawSizeBytes);
+}
+
+std::string SubsystemSensing::Pad(const std::string& _variable) {
+  std::string name = _variable;
+  if (name.size() < PacketRaw::kMaxStringSize) {
+    name.insert(0, PacketRaw::kMaxStringSize - name.size(), ' ');
+  }
+  return name;
+}
+
 void SubsystemSensing::Flush(const SimulationClock& _clock, const int _node_index) {
-  std::stringstream stream;
-  std::string str = sensor_->kVariable();
-  str.erase(std::remove(str.begin(), str.end(), ' '), str.end());
-  stream << "output/"
-         << std::fixed
-         << std::setw(10)
-         << std::setfill('0')
-         << _clock.elapsed_s()
-         << "s_N"
-         << std::fixed
-         << std::setw(5)
-         << std::setfill('0')
-         << _node_index
-         << "_"
-         << str
-         << "_measure.nc4";
-  DataLogger log(stream.str());
-  uint64_t length = buffer_.elapsed_s.size();
-  log.Measurement(length);
-  log.LogSeries("time", buffer_.elapsed_s.data(), length);
-  log.LogSeries("year", buffer_.year.data(), length);
-  log.LogSeries("month", buffer_.month.data(), length);
-  log.LogSeries("day", buffer_.day.data(), length);
-  log.LogSeries("hour", buffer_.hour.data(), length);
-  log.LogSeries("minute", buffer_.minute.data(), length);
-  log.LogSeries("second", buffer_.second.data(), length);
-  log.LogSeries("microsecond", buffer_.microsecond.data(), length);
-  log.LogSeries("latitude", buffer_.latitude_rad.data(), length);
-  log.LogSeries("longitude", buffer_.longitude_rad.data(), length);
-  log.LogSeries("altitude", buffer_.altitude_m.data(), length);
-  log.LogSeries("measurement", buffer_.measurement.data(), length);
-  log.LogSeries("resolution", buffer_.resolution_m.data(), length);
-  log.LogSeries("index", buffer_.index.data(), length);
+  if (measurement_log_ != nullptr) {
+    measurement_log_->Append(buffer_, _clock.elapsed_s(), _node_index);
+  } else {
+    std::stringstream stream;
+    std::string str = sensor_->kVariable();
+    str.erase(std::remove(str.begin(), str.end(), ' '), str.end());
+    stream << "output/"
+           << std::fixed
+           << std::setw(10)
+           << std::setfill('0')
+           << _clock.elapsed_s()
+           << "s_N"
+           << std::fixed
+           << std::setw(5)
+           << std::setfill('0')
+           << _node_index
+           << "_"
+           << str
+           << "_measure.nc4";
+    DataLogger log(stream.str());
+    uint64_t length = buffer_.elapsed_s.size();
+    log.Measurement(length);
+    log.LogSeries("time", buffer_.elapsed_s.data(), length);
+    log.LogSeries("year", buffer_.year.data(), length);
+    log.LogSeries("month", buffer_.month.data(), length);
+    log.LogSeries("day", buffer_.day.data(), length);
+    log.LogSeries("hour", buffer_.hour.data(), length);
+    log.LogSeries("minute", buffer_.minute.data(), length);
+    log.LogSeries("second", buffer_.second.data(), length);
+    log.LogSeries("microsecond", buffer_.microsecond.data(), length);
+    log.LogSeries("latitude", buffer_.latitude_rad.data(), length);
+    log.LogSeries("longitude", buffer_.longitude_rad.data(), length);
+    log.LogSeries("altitude", buffer_.altitude_m.data(), length);
+    log.LogSeries("measurement", buffer_.measurement.data(), length);
+    log.LogSeries("resolution", buffer_.resolution_m.data(), length);
+    log.LogSeries("index", buffer_.index.data(), length);
+  }
   buffer_.elapsed_s.clear();
   buffer_.year.clear();
   buffer_.month.clear();
@@ -169,19 +330,28 @@ void SubsystemSensing::OrientAntenna(const ReferenceFrame& _orbit_frame,
 }
 
 void SubsystemSensing::LoadData(const std::vector<uint8_t>& _payload) {
-  for (auto byte : _payload) {
-    data_buffer_.push_back(byte);
-  }
+  data_buffer_.insert(data_buffer_.end(), _payload.begin(), _payload.end());
 }
 
 void SubsystemSensing::EraseDataBuffer() {
-  std::vector<uint8_t> empty;
-  data_buffer_ = empty;
+  data_buffer_.clear();
+}
+
+std::vector<uint8_t> SubsystemSensing::ReleaseDataBuffer() {
+  std::vector<uint8_t> data_buffer;
+  data_buffer.swap(data_buffer_);
+  return data_buffer;
 }
 
-void SubsystemSensing::set_data_buffer(
-    const std::vector<uint8_t>& _data_buffer) {
-  data_buffer_ = _data_buffer;
+void SubsystemSensing::set_data_buffer(std::vector<uint8_t> _data_buffer) {
+  data_buffer_ = std::move(_data_buffer);
+}
+
+void SubsystemSensing::set_footprint(const bool& _footprint) {
+  footprint_ = _footprint;
+  if (footprint_) {
+    EarthData::TrackFootprint(sensor_->kVariable());
+  }
 }
 
 }  // namespace collaborate
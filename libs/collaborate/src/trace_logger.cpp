@@ -0,0 +1,257 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "collaborate/trace_logger.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "collaborate/data_logger.h"
+
+namespace osse {
+namespace collaborate {
+
+constexpr char TraceLogger::kMagic[8];
+
+TraceLogger::TraceLogger(const std::string& _path)
+    : path_(_path),
+      file_(-1),
+      data_(nullptr),
+      size_(0),
+      num_nodes_(0),
+      ticks_(0),
+      layout_({}),
+      columns_({}),
+      dropped_({}) {
+  file_ = open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (file_ < 0) {
+    std::cerr << path_ << ": " << std::strerror(errno) << std::endl;
+  }
+}
+
+TraceLogger::~TraceLogger() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+  if (file_ >= 0) {
+    close(file_);
+  }
+}
+
+void TraceLogger::SimulationMatrix(const uint16_t& _num_nodes,
+                                   const uint64_t& _ticks) {
+  num_nodes_ = _num_nodes;
+  ticks_ = _ticks;
+  AddColumn("step_tick", "uint64", sizeof(uint64_t), 1);
+  AddColumn("step_s", "uint64", sizeof(uint64_t), 1);
+  AddColumn("year", "int", sizeof(int), 1);
+  AddColumn("month", "int", sizeof(int), 1);
+  AddColumn("day", "int", sizeof(int), 1);
+  AddColumn("hour", "int", sizeof(int), 1);
+  AddColumn("minute", "int", sizeof(int), 1);
+  AddColumn("second", "int", sizeof(int), 1);
+  AddColumn("microsecond", "int", sizeof(int), 1);
+  AddColumn("area", "double", sizeof(double), _num_nodes);
+  AddColumn("charging", "byte", sizeof(int8_t), _num_nodes);
+  AddColumn("constellation", "ushort", sizeof(uint16_t), _num_nodes);
+  AddColumn("energy", "double", sizeof(double), _num_nodes);
+  AddColumn("index", "ushort", sizeof(uint16_t), _num_nodes);
+  AddColumn("latitude", "double", sizeof(double), _num_nodes);
+  AddColumn("longitude", "double", sizeof(double), _num_nodes);
+  AddColumn("altitude", "double", sizeof(double), _num_nodes);
+  AddColumn("mode", "uint64", sizeof(uint64_t), _num_nodes);
+  AddColumn("num_neighbors", "ushort", sizeof(uint16_t), _num_nodes);
+  Map();
+}
+
+void TraceLogger::AddColumn(const std::string& _name,
+                            const std::string& _type,
+                            const uint64_t& _size,
+                            const uint64_t& _rows) {
+  Column column = {};
+  _name.copy(column.name, kNameLength - 1);
+  _type.copy(column.type, kTypeLength - 1);
+  column.rows = _rows;
+  column.size = _size;
+  layout_.push_back(column);
+}
+
+void TraceLogger::Map() {
+  if (file_ < 0) {
+    return;
+  }
+  uint64_t offset = sizeof(Header) + layout_.size() * sizeof(Column);
+  offset = (offset + kAlignment - 1) / kAlignment * kAlignment;
+  for (auto& column : layout_) {
+    column.offset = offset;
+    offset += column.rows * ticks_ * column.size;
+    offset = (offset + kAlignment - 1) / kAlignment * kAlignment;
+  }
+  if (ftruncate(file_, offset) != 0) {
+    std::cerr << path_ << ": " << std::strerror(errno) << std::endl;
+    return;
+  }
+  void* data = mmap(nullptr,
+                    offset,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED,
+                    file_,
+                    0);
+  if (data == MAP_FAILED) {
+    std::cerr << path_ << ": " << std::strerror(errno) << std::endl;
+    return;
+  }
+  data_ = static_cast<char*>(data);
+  size_ = offset;
+  Header header = {};
+  std::memcpy(header.magic, kMagic, sizeof(header.magic));
+  header.version = kVersion;
+  header.num_columns = layout_.size();
+  header.num_nodes = num_nodes_;
+  header.ticks = ticks_;
+  std::memcpy(data_, &header, sizeof(header));
+  Column* columns = reinterpret_cast<Column*>(data_ + sizeof(Header));
+  for (uint64_t i = 0; i < layout_.size(); ++i) {
+    columns[i] = layout_[i];
+    columns_[layout_[i].name] = &columns[i];
+  }
+}
+
+TraceLogger::Column* TraceLogger::Find(const std::string& _variable,
+                                       const uint64_t& _size,
+                                       const uint64_t& _index,
+                                       const uint64_t& _count) {
+  if (data_ == nullptr) {
+    return nullptr;
+  }
+  auto it = columns_.find(_variable);
+  const char* reason = nullptr;
+  if (it == columns_.end()) {
+    reason = "no such column";
+  } else if (it->second->size != _size) {
+    reason = "value size mismatch";
+  } else if (_index + _count > ticks_) {
+    reason = "past the last tick";
+  }
+  if (reason != nullptr) {
+    if (dropped_.insert(_variable).second) {
+      std::cerr << path_ << ": dropped write to " << _variable << " at "
+                << _index << " (" << reason << ")" << std::endl;
+    }
+    return nullptr;
+  }
+  it->second->length = std::max(it->second->length, _index + _count);
+  return it->second;
+}
+
+bool TraceLogger::Convert(const std::string& _trace_path,
+                          const std::string& _netcdf_path) {
+  int file = open(_trace_path.c_str(), O_RDONLY);
+  if (file < 0) {
+    std::cerr << _trace_path << ": " << std::strerror(errno) << std::endl;
+    return false;
+  }
+  struct stat status;
+  if ((fstat(file, &status) != 0)
+      || (static_cast<uint64_t>(status.st_size) < sizeof(Header))) {
+    std::cerr << _trace_path << ": not a trace" << std::endl;
+    close(file);
+    return false;
+  }
+  uint64_t size = status.st_size;
+  void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+  close(file);
+  if (data == MAP_FAILED) {
+    std::cerr << _trace_path << ": " << std::strerror(errno) << std::endl;
+    return false;
+  }
+  const char* bytes = static_cast<const char*>(data);
+  Header header;
+  std::memcpy(&header, bytes, sizeof(header));
+  if ((std::memcmp(header.magic, kMagic, sizeof(header.magic)) != 0)
+      || (header.version != kVersion)
+      || (sizeof(Header) + header.num_columns * sizeof(Column) > size)) {
+    std::cerr << _trace_path << ": not a trace" << std::endl;
+    munmap(data, size);
+    return false;
+  }
+  const Column* columns = reinterpret_cast<const Column*>(bytes
+                                                          + sizeof(Header));
+  {
+    DataLogger data_log(_netcdf_path);
+    data_log.SimulationMatrix(header.num_nodes, header.ticks);
+    for (uint32_t i = 0; i < header.num_columns; ++i) {
+      const Column& column = columns[i];
+      if (column.offset + column.rows * header.ticks * column.size > size) {
+        std::cerr << _trace_path << ": truncated " << column.name << std::endl;
+        continue;
+      }
+      std::string type(column.type);
+      if (type == "int") {
+        ConvertColumn<int>(&data_log, column, bytes, header.ticks);
+      } else if (type == "double") {
+        ConvertColumn<double>(&data_log, column, bytes, header.ticks);
+      } else if (type == "byte") {
+        ConvertColumn<int8_t>(&data_log, column, bytes, header.ticks);
+      } else if (type == "ushort") {
+        ConvertColumn<uint16_t>(&data_log, column, bytes, header.ticks);
+      } else if (type == "uint64") {
+        ConvertColumn<uint64_t>(&data_log, column, bytes, header.ticks);
+      }
+    }
+  }
+  munmap(data, size);
+  return true;
+}
+
+template <class T>
+void TraceLogger::ConvertColumn(DataLogger* _data_log,
+                                const Column& _column,
+                                const char* _data,
+                                const uint64_t& _ticks) {
+  uint64_t length = _column.length;
+  if ((length == 0) || (_column.size != sizeof(T))) {
+    return;
+  }
+  // Pack each row's written ticks, since the log may have stopped early
+  std::vector<T> values(_column.rows * length);
+  for (uint64_t r = 0; r < _column.rows; ++r) {
+    std::memcpy(&values[r * length],
+                _data + _column.offset + r * _ticks * sizeof(T),
+                length * sizeof(T));
+  }
+  if (_column.rows == 1) {
+    _data_log->LogSeries(_column.name, values.data(), 0, length);
+  } else {
+    _data_log->LogMatrix(_column.name,
+                         values.data(),
+                         0,
+                         _column.rows,
+                         length);
+  }
+}
+
+}  // namespace collaborate
+}  // namespace osse
@@ -150,48 +150,85 @@ bool Tree::IsLeaf(Branch* _branch) const {
 }
 
 void Tree::Log(const std::string& _path) const {
+  WriteDocument(Flatten(), _path);
+}
+
+void Tree::WriteDocument(const std::vector<Entry>& _entries,
+                         const std::string& _path) {
   std::ofstream ofstream(_path, std::ios::out | std::ios::trunc);
   // Preamble
   ofstream << "\\documentclass[tikz, border=0pt]{standalone}" << std::endl;
   ofstream << "\\usepackage{tikz}" << std::endl;
   ofstream << "\\usepackage[linguistics]{forest}" << std::endl;
   ofstream << "\\begin{document}" << std::endl;
-  ofstream << "\\begin{forest}" << std::endl;
-  ofstream << "for tree={l sep+=100pt}";
-  // Loop
+  WriteForest(_entries, &ofstream);
+  ofstream << "\\end{document}" << std::endl;
+  ofstream.close();
+}
+
+std::vector<Tree::Entry> Tree::Flatten() const {
+  std::vector<Entry> entries;
+  entries.reserve(size_);
   std::stack<Branch*> stack;
   stack.push(root_);
-  uint8_t current_level = 0;
   while (!stack.empty()) {
     Tree::Branch* branch = stack.top();
     stack.pop();
-    for (uint8_t i = branch->level; i < current_level; ++i) {
-      ofstream << "]";
+    entries.push_back({branch->level,
+                       branch->identity->index(),
+                       branch->rx_time_s,
+                       IsLeaf(branch)});
+    for (auto child : branch->children) {
+      stack.push(child);
+    }
+  }
+  return entries;
+}
+
+void Tree::WriteForest(const std::vector<Entry>& _entries,
+                       std::ostream* _stream) {
+  *_stream << "\\begin{forest}" << std::endl;
+  *_stream << "for tree={l sep+=100pt}";
+  uint8_t current_level = 0;
+  for (auto& entry : _entries) {
+    for (uint8_t i = entry.level; i < current_level; ++i) {
+      *_stream << "]";
     }
-    ofstream << std::endl;
-    current_level = branch->level;
-    for (uint8_t i = 0; i < branch->level; ++i) {
-      ofstream << "  ";
+    *_stream << std::endl;
+    current_level = entry.level;
+    for (uint8_t i = 0; i < entry.level; ++i) {
+      *_stream << "  ";
     }
-    ofstream << "["
-             << branch->identity->index()
-             << " \\\\ "
-             << branch->rx_time_s;
-    if (IsLeaf(branch)) {
-      ofstream << "]";
-    } else {
-      for (auto child : branch->children) {
-        stack.push(child);
-      }
+    *_stream << "[" << entry.index << " \\\\ " << entry.rx_time_s;
+    if (entry.leaf) {
+      *_stream << "]";
     }
   }
   for (uint8_t i = 0; i < current_level; ++i) {
-    ofstream << "]";
+    *_stream << "]";
+  }
+  *_stream << std::endl;
+  *_stream << "\\end{forest}" << std::endl;
+}
+
+void Tree::WriteEdges(const std::vector<Entry>& _entries,
+                      const std::string& _prefix,
+                      std::ostream* _stream) {
+  // Most recent node at each level, so the parent is the one a level up
+  std::vector<uint16_t> path;
+  for (auto& entry : _entries) {
+    path.resize(entry.level + 1);
+    path[entry.level] = entry.index;
+    uint16_t parent = entry.index;
+    if (entry.level > 0) {
+      parent = path[entry.level - 1];
+    }
+    *_stream << _prefix << " "
+             << entry.level << " "
+             << parent << " "
+             << entry.index << " "
+             << entry.rx_time_s << "\n";
   }
-  ofstream << std::endl;
-  ofstream << "\\end{forest}" << std::endl;
-  ofstream << "\\end{document}" << std::endl;
-  ofstream.close();
 }
 
 }  // namespace collaborate
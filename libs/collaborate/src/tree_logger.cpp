@@ -0,0 +1,126 @@
+// Copyright (C) 2019 The Ohio State University
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "collaborate/tree_logger.h"
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "collaborate/tree.h"
+
+namespace osse {
+namespace collaborate {
+
+TreeLogger::TreeLogger(const std::string& _path,
+                       const kFormat& _format,
+                       const uint64_t& _every)
+    : path_(_path),
+      format_(_format),
+      every_(_every == 0 ? 1 : _every),
+      num_trees_(0),
+      stopping_(false) {
+  if (format_ != kFormat::TikzFiles) {
+    file_.open(path_, std::ios::out | std::ios::trunc);
+  }
+  if (format_ == kFormat::EdgeList) {
+    file_ << "# elapsed_s start end level parent node rx_time_s" << std::endl;
+  }
+  writer_ = std::thread(&TreeLogger::Drain, this);
+}
+
+TreeLogger::~TreeLogger() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stopping_ = true;
+  }
+  queue_ready_.notify_one();
+  writer_.join();
+  if (file_.is_open()) {
+    file_.close();
+  }
+}
+
+void TreeLogger::Save(const uint16_t& _start,
+                      const uint16_t& _end,
+                      const uint64_t& _elapsed_s,
+                      const Tree& _tree) {
+  ++num_trees_;
+  if ((num_trees_ - 1) % every_ != 0) {
+    return;
+  }
+  Request request = {_start, _end, _elapsed_s, _tree.Flatten()};
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  while (queue_.size() >= kQueueDepth) {
+    queue_space_.wait(lock);
+  }
+  queue_.push_back(std::move(request));
+  lock.unlock();
+  queue_ready_.notify_one();
+}
+
+void TreeLogger::Drain() {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  while (true) {
+    while (queue_.empty() && !stopping_) {
+      queue_ready_.wait(lock);
+    }
+    if (queue_.empty()) {
+      return;
+    }
+    Request request = std::move(queue_.front());
+    queue_.pop_front();
+    lock.unlock();
+    queue_space_.notify_one();
+    Write(request);
+    lock.lock();
+  }
+}
+
+void TreeLogger::Write(const Request& _request) {
+  std::stringstream stream;
+  switch (format_) {
+  case(kFormat::TikzFiles):
+    stream << path_
+           << _request.start
+           << "_"
+           << _request.end
+           << "_"
+           << _request.elapsed_s
+           << ".tex";
+    Tree::WriteDocument(_request.entries, stream.str());
+    break;
+  case(kFormat::Tikz):
+    file_ << "% tree "
+          << _request.start << " "
+          << _request.end << " "
+          << _request.elapsed_s << std::endl;
+    Tree::WriteForest(_request.entries, &file_);
+    break;
+  case(kFormat::EdgeList):
+    stream << _request.elapsed_s << " " << _request.start << " "
+           << _request.end;
+    Tree::WriteEdges(_request.entries, stream.str(), &file_);
+    break;
+  }
+}
+
+}  // namespace collaborate
+}  // namespace osse
@@ -19,6 +19,34 @@ namespace osse {
 namespace collaborate {
 namespace util {
 
+uint16_t HalfFromFloat(const float& _value) {
+  uint32_t bits;
+  std::memcpy(&bits, &_value, sizeof(bits));
+  uint16_t sign = (bits >> 16) & 0x8000;
+  uint32_t magnitude = bits & 0x7fffffff;
+  if (magnitude >= 0x7f800000) {
+    // Infinity, or a quiet NaN
+    return sign | 0x7c00 | ((magnitude > 0x7f800000) ? 0x200 : 0);
+  }
+  if (magnitude >= 0x477ff000) {
+    // Rounds past the largest half (65504)
+    return sign | 0x7c00;
+  }
+  if (magnitude < 0x38800000) {
+    // Subnormal half, in units of 2^-24
+    float scaled = std::ldexp(std::abs(_value), 24);
+    return sign | static_cast<uint16_t>(std::nearbyint(scaled));
+  }
+  uint32_t mantissa = magnitude & 0x7fffff;
+  uint32_t half = (((magnitude >> 23) - 112) << 10) | (mantissa >> 13);
+  uint32_t remainder = mantissa & 0x1fff;
+  if ((remainder > 0x1000) || ((remainder == 0x1000) && ((half & 1) != 0))) {
+    // A carry into the exponent is still correctly rounded
+    ++half;
+  }
+  return sign | static_cast<uint16_t>(half);
+}
+
 double MinimumRoot(const Polynomial& _coefficients) {
   Polynomial reverse = _coefficients;
   std::reverse(reverse.begin(), reverse.end());
@@ -27,7 +27,7 @@ import pickle
 import sys
 
 from helper_data import read_data
-from helper_data import read_measurement
+from helper_data import read_measurements
 from helper_plot import map_blue_marble
 from helper_plot import remove_margins
 from helper_plot import scatter_small_red
@@ -76,7 +76,6 @@ def main():
         c_rain_files = paths_which_contain(f'output/{substr}/', 'PRECTOT')
         c_optical_files = paths_which_contain(f'output/{substr}/', 'TAUTOT')
         c_optical_files = [f for f in c_optical_files if f[-4:] == '.nc4']
-        c_optical_files = [f for f in c_optical_files if int(f[23:28]) >= num_sources]
         c_rain_files = [f for f in c_rain_files if f[-4:] == '.nc4']
 
         if len(c_rain_files) == 0:
@@ -84,10 +83,11 @@ def main():
         if len(c_optical_files) == 0:
             sys.exit('Error: no collaborative optical measurements.')
 
-        def load_data(data, files):
+        def load_data(data, files, min_node=0):
             for filename in files:
-                log, index, _ = read_measurement(filename)
-                data.append(np.array(log['measurement']))
+                for log, node, _ in read_measurements(filename):
+                    if node >= min_node:
+                        data.append(np.array(log['measurement']))
 
         s_rain_data = []
         s_optical_data = []
@@ -96,7 +96,7 @@ def main():
         load_data(s_rain_data, s_rain_files)
         load_data(c_rain_data, c_rain_files)
         load_data(s_optical_data, s_optical_files)
-        load_data(c_optical_data, c_optical_files)
+        load_data(c_optical_data, c_optical_files, num_sources)
 
         def test_rain(data):
             counts = []
@@ -112,6 +112,49 @@ def archive_measurement(path):
     return structure
 
 
+def archive_measurements(path):
+    """
+    Reads a ragged-array measurement log into a pandas structure.
+
+    Each sample is tagged with the 'instance' (measurement) it belongs to,
+    the measuring 'node' and the 'complete' time of its measurement.
+
+    Args:
+        path (str): A file path
+
+    Returns:
+        DataFrame
+
+    Examples:
+        >>> dataframe = archive_measurements('TAUTOT_measure.nc4')
+    """
+    data = Dataset(path)
+    dtv = ['year', 'month', 'day', 'hour', 'minute', 'second', 'microsecond']
+    tup = list(zip(*[list(data.variables[v][:].data) for v in dtv]))
+    times = range(len(data.dimensions['obs']))
+    stamps = ['{}-{:02d}-{:02d} {:02d}:{:02d}:{:02d}:{:02d}'.format(*tup[idx])
+              for idx in times]
+    row_size = np.array(data.variables['row_size'][:], dtype=np.int64)
+    instances = np.arange(len(row_size))
+    structure = pd.DataFrame({'tick': data.variables['time'][:],
+                              'latitude': data.variables['latitude'][:],
+                              'longitude': data.variables['longitude'][:],
+                              'altitude': data.variables['altitude'][:],
+                              'measurement': data.variables['measurement'][:],
+                              'resolution': data.variables['resolution'][:],
+                              'index': data.variables['index'][:],
+                              'instance': np.repeat(instances, row_size),
+                              'node': np.repeat(data.variables['node'][:],
+                                                row_size),
+                              'complete': np.repeat(
+                                  data.variables['complete'][:], row_size)},
+                             index=stamps)
+    structure['latitude'] = np.degrees(structure['latitude'])
+    structure['longitude'] = np.degrees(structure['longitude'])
+    structure.index.names = ['time']
+    return structure
+
+
 def archive_node_parameters(path):
     """
     Reads a node parameter log into a pandas structure.
@@ -126,12 +169,23 @@ def archive_node_parameters(path):
         >>> dataframe = archive_node_parameters('log.nc4')
     """
     data = Dataset(path)
-    stamps = []
-    tup = list(zip(*[list(data.variables[v][:].data) for v in data.variables]))
-    times = range(len(data.dimensions['time']))
-    stamps = ['{}-{:02d}-{:02d} {:02d}:{:02d}:{:02d}:{:02d}'.format(*tup[idx])
-              for idx in times]
+    stamps = clock_stamps(data, len(data.dimensions['time']))
     frames = dict()
+    if 'node' in data.dimensions:
+        # One [node, time] variable per parameter
+        parameters = ['area', 'charging', 'constellation', 'energy', 'index',
+                      'latitude', 'longitude', 'mode', 'num_neighbors']
+        columns = {p: data.variables[p][:] for p in parameters}
+        for node in range(len(data.dimensions['node'])):
+            frm = pd.DataFrame({p: columns[p][node, :] for p in parameters},
+                               index=stamps)
+            frm['latitude'] = np.degrees(frm['latitude'])
+            frm['longitude'] = np.degrees(frm['longitude'])
+            frames['{:06d}'.format(node)] = frm
+        structure = pd.concat(frames.values(), axis=1,
+                              keys=frames.keys()).stack(0)
+        structure.index.names = ['time', 'node']
+        return structure
     for group in data.groups:
         current_group = data.groups[group]
         frm = pd.DataFrame({'area': current_group['area'][:],
@@ -152,6 +206,39 @@ def archive_node_parameters(path):
     return structure
 
 
+def clock_stamps(data, ticks):
+    """
+    Expands a run-length encoded simulation clock into one stamp per tick.
+
+    Each run (along the 'step' dimension) holds its first tick, its step in
+    seconds, and the date and time at its first tick.
+
+    Args:
+        data  (netCDF4.Dataset): A node parameter log
+        ticks (int): The number of ticks
+
+    Returns:
+        list
+
+    Examples:
+        >>> stamps = clock_stamps(Dataset('data.nc4'), 3600)
+        >>> stamps[1]
+        '2019-01-01 00:00:01:00'
+    """
+    clock = ['year', 'month', 'day', 'hour', 'minute', 'second', 'microsecond']
+    starts = pd.to_datetime(pd.DataFrame(
+        {v: data.variables[v][:].data for v in clock}))
+    first = np.array(data.variables['step_tick'][:].data, dtype=np.int64)
+    step = np.array(data.variables['step_s'][:].data, dtype=np.int64)
+    tick = np.arange(ticks)
+    run = np.searchsorted(first, tick, side='right') - 1
+    times = starts.values[run] + pd.to_timedelta((tick - first[run])
+                                                 * step[run], unit='s')
+    return ['{}-{:02d}-{:02d} {:02d}:{:02d}:{:02d}:{:02d}'.format(
+        t.year, t.month, t.day, t.hour, t.minute, t.second, t.microsecond)
+            for t in pd.DatetimeIndex(times)]
+
+
 def generate_colors(data, cmap, alphas):
     """
     Creates an image from data, the colormap, and transparency data.
@@ -450,6 +537,42 @@ def read_data(path, variable):
     return colors
 
 
+def read_event_records(path):
+    """
+    Reads binary event records into a pandas structure.
+
+    Each 24-byte record holds the elapsed time (s), a type-dependent value,
+    a node, a peer node, and an event type (see EventLogger::EventRecord).
+
+    Args:
+        path (str): A file path
+
+    Returns:
+        DataFrame
+
+    Examples:
+        >>> events = read_event_records('output/events.bin')
+        >>> events[(events.node == 3) & (events.type == 'TransferEnd')]
+    """
+    print('Processing "{}"'.format(path))
+    record = np.dtype([('time', '<u8'),
+                       ('value', '<u8'),
+                       ('node', '<u2'),
+                       ('peer', '<u2'),
+                       ('type', 'u1'),
+                       ('reserved', 'u1', 3)])
+    types = ['TransferStart', 'TransferEnd', 'TransferFail', 'Prediction',
+             'Route', 'RouteHop', 'MeasurementStart']
+    records = np.fromfile(path, dtype=record)
+    structure = pd.DataFrame({'time': records['time'],
+                              'value': records['value'],
+                              'node': records['node'],
+                              'peer': records['peer'],
+                              'type': pd.Categorical.from_codes(
+                                  records['type'], types)})
+    return structure
+
+
 def read_measurement(path):
     """
     Reads a measurement DataFrame from a '.pkl' or a '.nc4' file.
@@ -478,6 +601,37 @@ def read_measurement(path):
     return structure, times, structure.columns
 
 
+def read_measurements(path):
+    """
+    Reads every measurement in a ragged-array '.pkl' or '.nc4' file.
+
+    Args:
+        path (str): A file path
+
+    Returns:
+        List of (DataFrame, node index, completion time) tuples
+
+    Example:
+        >>> for log, node, complete in read_measurements("TAUTOT_measure.nc4"):
+        ...     print(node, len(log))
+    """
+    prefix = os.path.splitext(path)[0]
+    archive = prefix + ".pkl"
+    if os.path.exists(archive):
+        print('Processing archive "{}"'.format(archive))
+        structure = pd.read_pickle(archive)
+    else:
+        print('Processing log "{}"'.format(path))
+        structure = archive_measurements(path)
+        structure.to_pickle(archive)
+    measurements = []
+    for _, log in structure.groupby('instance', sort=True):
+        measurements.append((log,
+                             int(log['node'].iloc[0]),
+                             int(log['complete'].iloc[0])))
+    return measurements
+
+
 def read_node_parameters(path):
     """
     Reads a node parameter DataFrame from a '.pkl' or a '.nc4' file.
@@ -590,8 +744,69 @@ def read_network_log(path):
     if path:
         print('Processing "{}"'.format(path))
         data = Dataset(path)
+        if 'event_time' in data.variables:
+            data.close()
+            for graph in reconstruct_network_log(path):
+                graphs.append(graph**0.5)
+            return graphs
         for idx in range(len(data.dimensions['time'])):
             graph = np.array(data.variables['edges'][:, :, idx])
             graph = graph**0.5
             graphs.append(graph)
     return graphs
+
+
+def reconstruct_network_log(path, tick=None):
+    """
+    Rebuilds adjacency matrices from a network transition log.
+
+    Events are replayed from the latest snapshot at or before the tick, or
+    from an empty graph when the log has no such snapshot.
+
+    Args:
+        path (str): The absolute path of the file
+        tick (int): A single tick to rebuild (every tick if None)
+
+    Returns:
+        list (every tick) or np.ndarray (single tick)
+
+    Examples:
+        >>> edges = reconstruct_network_log('network.nc4')
+        >>> edges
+        [array([[...]]), ... ]
+        >>> edge = reconstruct_network_log('network.nc4', 120)
+        >>> edge
+        array([[...]])
+    """
+    data = Dataset(path)
+    num_ticks = len(data.dimensions['time'])
+    shape = (len(data.dimensions['rx']), len(data.dimensions['tx']))
+    times = np.array(data.variables['event_time'][:], dtype=np.int64)
+    rows = np.array(data.variables['event_rx'][:], dtype=np.int64)
+    cols = np.array(data.variables['event_tx'][:], dtype=np.int64)
+    ons = np.array(data.variables['event_on'][:], dtype=np.int8)
+    snap_times = np.array(data.variables['snapshot_time'][:], dtype=np.int64)
+    last = num_ticks - 1 if tick is None else tick
+    graph = np.zeros(shape, dtype=np.int8)
+    first = 0
+    start = 0
+    if tick is not None:
+        candidates = np.nonzero(snap_times <= tick)[0]
+        if len(candidates) > 0:
+            snap = candidates[-1]
+            graph = np.array(data.variables['snapshot_edges'][snap, :, :],
+                             dtype=np.int8)
+            first = int(data.variables['snapshot_event'][snap])
+            start = int(snap_times[snap]) + 1
+    data.close()
+    graphs = []
+    event = first
+    for idx in range(start, last + 1):
+        while event < len(times) and times[event] <= idx:
+            graph[rows[event], cols[event]] = ons[event]
+            event += 1
+        if tick is None:
+            graphs.append(graph.copy())
+    if tick is None:
+        return graphs
+    return graph
@@ -24,7 +24,7 @@ import matplotlib.pyplot as plt
 import numpy as np
 
 from helper_data import read_data
-from helper_data import read_measurement
+from helper_data import read_measurements
 from helper_plot import map_blue_marble
 from helper_plot import remove_margins
 from helper_plot import scatter_small_red
@@ -61,10 +61,11 @@ def main():
     # Input
     args = argparser()
     data_files = paths_with_extension(args.data_dir, '.nc4')
-    paths = sorted(paths_which_contain(args.in_dir, "measure"))
+    paths = sorted(paths_which_contain(args.in_dir, "_measure.nc4"))
     data_index = -1
-    path = paths[args.index]
-    log, index, _ = read_measurement(path)
+    measurements = [(path, measurement) for path in paths
+                    for measurement in read_measurements(path)]
+    path, (log, node, complete) = measurements[args.index]
     # this_data_index = int(np.floor(log['tick'][0] / 1800))
     # if this_data_index != data_index:
     #     data_index = this_data_index
@@ -95,7 +96,7 @@ def main():
     plt.xticks([])
     plt.grid()
     plt.tight_layout()
-    out = f'{args.out_dir}{only_name(path)}_graph'
+    out = f'{args.out_dir}{only_name(path)}_{complete:010d}s_N{node:05d}_graph'
     plt.savefig(f'{out}.pdf')
     plt.savefig(f'{out}.png', dpi=300)
     plt.close()
@@ -24,7 +24,7 @@ import matplotlib.pyplot as plt
 import numpy as np
 
 from helper_data import read_data
-from helper_data import read_measurement
+from helper_data import read_measurements
 from helper_plot import map_blue_marble
 from helper_plot import remove_margins
 from helper_plot import scatter_small_red
@@ -63,22 +63,23 @@ def main():
     data_files = paths_with_extension(args.data_dir, '.nc4')
     paths1 = sorted(paths_which_contain(args.in_dir, "PRECTOT"))
     paths2 = sorted(paths_which_contain(args.in_dir, "TAUTOT"))
-    paths2 = [p for p in paths2 if '_N00000_' not in p]
-    paths = paths1 + paths2
+    paths = [p for p in paths1 + paths2 if p[-4:] == '.nc4']
     for path in paths:
-        log, index, _ = read_measurement(path)
-
-        # Graph
-        plt.figure(figsize=(9, 3))
-        plt.plot(log['measurement'])
-        plt.ylabel('Measurement')
-        plt.xlabel('Time')
-        plt.xticks([])
-        plt.grid()
-        plt.tight_layout()
-        out = f'{args.out_dir}{only_name(path)}_graph'
-        plt.savefig(f'{out}.png', dpi=300)
-        plt.close()
+        for log, node, complete in read_measurements(path):
+            if node == 0 and 'TAUTOT' in path:
+                continue
+
+            # Graph
+            plt.figure(figsize=(9, 3))
+            plt.plot(log['measurement'])
+            plt.ylabel('Measurement')
+            plt.xlabel('Time')
+            plt.xticks([])
+            plt.grid()
+            plt.tight_layout()
+            out = f'{args.out_dir}{only_name(path)}_{complete:010d}s_N{node:05d}'
+            plt.savefig(f'{out}_graph.png', dpi=300)
+            plt.close()
 
 
 def argparser():